@@ -8,8 +8,13 @@
 #include <iostream>
 #include <iterator>
 #include <numeric>
+#include <utility>
 #include <vector>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 #include "../primitives/math.hpp"
 
 namespace eopi {
@@ -52,6 +57,184 @@ void three_way_partition(const iterator_type begin, const iterator_type end,
   three_way_partition(begin, end, pivot, std::less<pivot_type>());
 }
 
+namespace details {
+// branchless two-way partition in the style of BlockQuicksort: the
+// classification of a block only records offsets of misplaced elements, so
+// the comparisons never feed into a branch. Elements satisfying to_left end up
+// in front, the returned iterator is the first element that does not
+template <typename iterator_type, typename predicate_type>
+iterator_type block_partition(iterator_type first, iterator_type last,
+                              predicate_type to_left) {
+  std::size_t const constexpr block = 64;
+  std::uint8_t offsets_left[block], offsets_right[block];
+  std::size_t num_left = 0, num_right = 0, start_left = 0, start_right = 0;
+
+  while (last - first > static_cast<std::ptrdiff_t>(2 * block)) {
+    if (num_left == 0) {
+      start_left = 0;
+      for (std::size_t i = 0; i < block; ++i) {
+        offsets_left[num_left] = static_cast<std::uint8_t>(i);
+        num_left += !to_left(first[i]);
+      }
+    }
+    if (num_right == 0) {
+      start_right = 0;
+      for (std::size_t i = 0; i < block; ++i) {
+        offsets_right[num_right] = static_cast<std::uint8_t>(i);
+        num_right += to_left(*(last - 1 - i));
+      }
+    }
+
+    auto const swaps = std::min(num_left, num_right);
+    for (std::size_t i = 0; i < swaps; ++i)
+      std::swap(first[offsets_left[start_left + i]],
+                *(last - 1 - offsets_right[start_right + i]));
+
+    num_left -= swaps, num_right -= swaps;
+    start_left += swaps, start_right += swaps;
+    if (num_left == 0)
+      first += block;
+    if (num_right == 0)
+      last -= block;
+  }
+
+  // everything before first / from last on is in place, a partially processed
+  // block only means some elements in [first,last) are already correct
+  while (true) {
+    while (first != last && to_left(*first))
+      ++first;
+    while (first != last && !to_left(*(last - 1)))
+      --last;
+    if (first == last)
+      return first;
+    std::swap(*first, *(last - 1));
+  }
+}
+
+// permutations moving the lanes of an 8 bit mask to the front, keeping the
+// order of lanes within both groups
+struct CompressLookupTable {
+  constexpr CompressLookupTable() : permutation() {
+    for (std::uint32_t mask = 0; mask < 256; ++mask) {
+      std::uint32_t pos = 0;
+      for (std::uint32_t lane = 0; lane < 8; ++lane)
+        if (mask & (1u << lane))
+          permutation[mask][pos++] = lane;
+      for (std::uint32_t lane = 0; lane < 8; ++lane)
+        if (!(mask & (1u << lane)))
+          permutation[mask][pos++] = lane;
+    }
+  }
+
+  std::uint32_t permutation[256][8];
+};
+
+#if defined(__AVX2__)
+// in-place two-way partition of 32 bit integers, compress-storing eight
+// elements at a time to both ends of the range. The vector predicate returns
+// the 8 bit mask of lanes that go to the left
+template <typename vector_predicate, typename scalar_predicate>
+std::int32_t *compress_partition(std::int32_t *const begin,
+                                 std::int32_t *const end,
+                                 vector_predicate to_left_mask,
+                                 scalar_predicate to_left) {
+  if (end - begin < 16)
+    return block_partition(begin, end, to_left);
+
+  static const CompressLookupTable lookup;
+  auto const load = [](std::int32_t const *from) {
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(from));
+  };
+
+  // the outermost vectors are cached, which guarantees at least eight free
+  // slots on the side that is written next
+  auto const cached_front = load(begin), cached_back = load(end - 8);
+  auto left_write = begin, right_write = end;
+  auto left_read = begin + 8, right_read = end - 8;
+
+  auto const store = [&](__m256i const values) {
+    auto const mask = to_left_mask(values);
+    auto const compressed = _mm256_permutevar8x32_epi32(
+        values, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(
+                    lookup.permutation[mask])));
+    auto const count = __builtin_popcount(mask);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(left_write), compressed);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(right_write - 8),
+                        compressed);
+    left_write += count;
+    right_write -= 8 - count;
+  };
+
+  while (right_read - left_read >= 8) {
+    // read from the side with less free space
+    if (left_read - left_write <= right_write - right_read) {
+      store(load(left_read));
+      left_read += 8;
+    } else {
+      right_read -= 8;
+      store(load(right_read));
+    }
+  }
+
+  // the remaining elements are copied first, the scalar writes may cover them
+  std::int32_t rest[24];
+  auto rest_end = std::copy(left_read, right_read, rest);
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(rest_end), cached_front);
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(rest_end + 8), cached_back);
+  rest_end += 16;
+  for (auto itr = rest; itr != rest_end; ++itr) {
+    if (to_left(*itr))
+      *left_write++ = *itr;
+    else
+      *--right_write = *itr;
+  }
+  return left_write;
+}
+#endif
+} // namespace details
+
+// three way partition by two branchless block partitioning passes (< pivot,
+// then <= pivot). Returns the begin of the equal and the greater range
+template <typename iterator_type, typename pivot_type, typename comparator_type>
+std::pair<iterator_type, iterator_type>
+three_way_partition_blocked(iterator_type const begin, iterator_type const end,
+                            pivot_type const &pivot, comparator_type less) {
+  auto const equal = details::block_partition(
+      begin, end, [&](auto const &value) { return less(value, pivot); });
+  auto const greater = details::block_partition(
+      equal, end, [&](auto const &value) { return !less(pivot, value); });
+  return {equal, greater};
+}
+
+// three way partition of 32 bit keys, using AVX2 compress-stores if available
+inline std::pair<std::int32_t *, std::int32_t *>
+three_way_partition_vectorised(std::int32_t *const begin,
+                               std::int32_t *const end,
+                               std::int32_t const pivot) {
+#if defined(__AVX2__)
+  auto const pivots = _mm256_set1_epi32(pivot);
+  auto const equal = details::compress_partition(
+      begin, end,
+      [pivots](__m256i const values) {
+        return _mm256_movemask_ps(
+            _mm256_castsi256_ps(_mm256_cmpgt_epi32(pivots, values)));
+      },
+      [pivot](std::int32_t const value) { return value < pivot; });
+  auto const greater = details::compress_partition(
+      equal, end,
+      [pivots](__m256i const values) {
+        return ~_mm256_movemask_ps(_mm256_castsi256_ps(
+                   _mm256_cmpgt_epi32(values, pivots))) &
+               0xFF;
+      },
+      [pivot](std::int32_t const value) { return value <= pivot; });
+  return {equal, greater};
+#else
+  return three_way_partition_blocked(begin, end, pivot,
+                                     std::less<std::int32_t>());
+#endif
+}
+
 template <typename iterator_type, typename key_type>
 iterator_type remove(iterator_type const begin, iterator_type const end,
                      key_type const key) {
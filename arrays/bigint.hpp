@@ -1,8 +1,10 @@
 #ifndef EOPI_ARRAYS_BIGINT_HPP_
 #define EOPI_ARRAYS_BIGINT_HPP_
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <iomanip>
 #include <vector>
 
@@ -59,16 +61,34 @@ class BigInt {
     }
 
     BigInt& operator+=(BigInt const& other) {
-        digits.resize(std::max(digits.size(), other.digits.size()));
-        std::int64_t carry = 0;
-        for (std::size_t i = 0; i < other.digits.size(); ++i) {
-            digits[i] = digits[i] + other.digits[i] + carry;
-            carry = digits[i] / CARRY_FROM;
-            digits[i] %= CARRY_FROM;
+        auto const negative = digits.back() < 0;
+        auto rhs = magnitude(other);
+        digits = magnitude(*this);
+        if (negative == (other.digits.back() < 0)) {
+            add_magnitude(digits, rhs);
+            set_sign(negative);
+        } else if (compare_magnitude(digits, rhs) >= 0) {
+            subtract_magnitude(digits, rhs);
+            set_sign(negative);
+        } else {
+            subtract_magnitude(rhs, digits);
+            digits.swap(rhs);
+            set_sign(!negative);
         }
         return *this;
     }
 
+    BigInt& operator-=(BigInt const& other) { return *this += -other; }
+
+    friend BigInt operator-(BigInt value) {
+        value.digits.back() = -value.digits.back();
+        return value;
+    }
+
+    friend BigInt operator-(BigInt lhs, BigInt const& rhs) {
+        return lhs -= rhs;
+    }
+
     friend BigInt operator+(BigInt lhs, BigInt const& rhs) {
         return lhs += rhs;
     }
@@ -98,13 +118,30 @@ class BigInt {
         if( lhs.digits.size() < rhs.digits.size() )
             return rhs * lhs;
 
-        BigInt result(0);
-        auto sign = lhs.digits.back() * rhs.digits.back() < 0 ? -1 : 1;
-
-
-
-        // can treat all digits as aboslute values now
+        auto sign = (lhs.digits.back() < 0) != (rhs.digits.back() < 0) ? -1 : 1;
+
+        // can treat all digits as aboslute values now, schoolbook product
+        // where every partial product stays below 10^18
+        std::vector<std::uint64_t> product(
+            lhs.digits.size() + rhs.digits.size(), 0);
+        for (std::size_t i = 0; i < rhs.digits.size(); ++i) {
+            auto const factor =
+                static_cast<std::uint64_t>(std::abs(rhs.digits[i]));
+            std::uint64_t carry = 0;
+            for (std::size_t j = 0; j < lhs.digits.size(); ++j) {
+                auto const current =
+                    product[i + j] + carry +
+                    factor * static_cast<std::uint64_t>(
+                                 std::abs(lhs.digits[j]));
+                product[i + j] = current % CARRY_FROM;
+                carry = current / CARRY_FROM;
+            }
+            product[i + lhs.digits.size()] += carry;
+        }
+        while (product.size() > 1 && product.back() == 0) product.pop_back();
 
+        BigInt result(0);
+        result.digits.assign(product.begin(), product.end());
         result.digits.back() *= sign;
         return result;
     }
@@ -137,6 +174,50 @@ class BigInt {
     }
 
    private:
+    // the digits of |value|, least significant first
+    static std::vector<std::int64_t> magnitude(BigInt const& value) {
+        auto result = value.digits;
+        result.back() = std::abs(result.back());
+        return result;
+    }
+
+    static int compare_magnitude(std::vector<std::int64_t> const& lhs,
+                                 std::vector<std::int64_t> const& rhs) {
+        if (lhs.size() != rhs.size()) return lhs.size() < rhs.size() ? -1 : 1;
+        for (auto i = lhs.size(); i-- > 0;)
+            if (lhs[i] != rhs[i]) return lhs[i] < rhs[i] ? -1 : 1;
+        return 0;
+    }
+
+    static void add_magnitude(std::vector<std::int64_t>& lhs,
+                              std::vector<std::int64_t> const& rhs) {
+        lhs.resize(std::max(lhs.size(), rhs.size()), 0);
+        std::int64_t carry = 0;
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            lhs[i] += (i < rhs.size() ? rhs[i] : 0) + carry;
+            carry = lhs[i] / CARRY_FROM;
+            lhs[i] %= CARRY_FROM;
+        }
+        if (carry) lhs.push_back(carry);
+    }
+
+    // |lhs| >= |rhs|
+    static void subtract_magnitude(std::vector<std::int64_t>& lhs,
+                                   std::vector<std::int64_t> const& rhs) {
+        std::int64_t borrow = 0;
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            lhs[i] -= (i < rhs.size() ? rhs[i] : 0) + borrow;
+            borrow = lhs[i] < 0 ? 1 : 0;
+            if (borrow) lhs[i] += CARRY_FROM;
+        }
+        while (lhs.size() > 1 && lhs.back() == 0) lhs.pop_back();
+    }
+
+    // the sign lives in the most significant digit, zero has none
+    void set_sign(bool const negative) {
+        if (negative) digits.back() = -digits.back();
+    }
+
     std::vector<std::int64_t> digits;
 };
 }  // namespace arrays
@@ -0,0 +1,54 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark/timing.hpp"
+#include "dp/algorithms.hpp"
+#include "dp/fuzzy_search.hpp"
+
+using namespace std;
+using eopi::benchmark::seconds;
+
+int main() {
+  {
+    // one query against a generated dictionary of 200000 words
+    vector<string> words;
+    for (uint32_t i = 0; i < 200000; ++i) {
+      string word;
+      for (auto value = i * 2654435761u; word.size() < 4 + i % 8; value /= 7)
+        word += static_cast<char>('a' + value % 7);
+      words.push_back(word);
+    }
+    size_t found = 0;
+    auto const elapsed = seconds([&]() {
+      found = eopi::dp::algorithms::closest_words("algoritm", words, 3).size();
+    });
+    cout << "Closest words: " << static_cast<uint64_t>(words.size() / elapsed)
+         << " words/s, found: " << found << endl;
+  }
+
+  {
+    // unit values with a huge capacity run as a bitset subset sum, few items
+    // with a huge capacity meet in the middle
+    using eopi::dp::algorithms::KnapsackItem;
+    vector<KnapsackItem> unit, few;
+    for (uint32_t i = 0; i < 100; ++i) {
+      auto const weight = (i * 2654435761u) % 1000000u + 1;
+      unit.emplace_back(weight, weight);
+    }
+    for (uint32_t i = 0; i < 32; ++i)
+      few.emplace_back((i * 40503u) % 1000u + 1,
+                       (i * 2654435761u) % 100000000u + 1);
+    for (auto const *items : {&unit, &few}) {
+      uint64_t value = 0;
+      auto const elapsed = seconds([&]() {
+        value = eopi::dp::algorithms::knapsack(*items, 20000000).value;
+      });
+      cout << "Knapsack " << items->size() << " items: " << elapsed
+           << "s, value: " << value << endl;
+    }
+  }
+
+  return 0;
+}
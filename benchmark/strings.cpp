@@ -0,0 +1,118 @@
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/timing.hpp"
+#include "strings/algorithm.hpp"
+#include "strings/bit_codes.hpp"
+#include "strings/integer_codecs.hpp"
+#include "strings/justify.hpp"
+
+using namespace std;
+using eopi::benchmark::seconds;
+
+int main() {
+  {
+    // in place on 64 MiB of text
+    string words;
+    words.reserve(1 << 26);
+    for (size_t i = 0; words.size() < (1 << 26); ++i)
+      words.append(1 + (i * 7919) % 12, static_cast<char>('a' + i % 26)) += ' ';
+
+    auto const reverse_time = seconds([&]() {
+      eopi::strings::reverse_words(&words[0], &words[0] + words.size());
+    });
+    auto const replace_time = seconds([&]() {
+      eopi::strings::remove_and_replace(&words[0], words.size() / 2,
+                                        words.size());
+    });
+    cout << "Reverse words: "
+         << static_cast<uint64_t>(words.size() / reverse_time / (1 << 20))
+         << " MiB/s, remove and replace: "
+         << static_cast<uint64_t>(words.size() / 2 / replace_time / (1 << 20))
+         << " MiB/s" << endl;
+  }
+  {
+    // binary runlength format on 64 MiB of runs
+    string runs;
+    runs.reserve(1 << 26);
+    for (size_t i = 0; runs.size() < (1 << 26); ++i)
+      runs.append(1 + (i * 7919) % 300, static_cast<char>('a' + i % 26));
+
+    vector<uint8_t> binary;
+    string restored;
+    auto const encode_time = seconds(
+        [&]() { binary = eopi::strings::runlength::encode_binary(runs); });
+    auto const decode_time = seconds(
+        [&]() { restored = eopi::strings::runlength::decode_binary(binary); });
+    cout << "Binary RLE: encode "
+         << static_cast<uint64_t>(runs.size() / encode_time / (1 << 20))
+         << " MiB/s, decode "
+         << static_cast<uint64_t>(runs.size() / decode_time / (1 << 20))
+         << " MiB/s, lossless: " << (restored == runs) << endl;
+  }
+  {
+    // bit-packed and block codecs, decode throughput over one million gaps
+    vector<uint32_t> gaps(1 << 20);
+    for (size_t i = 0; i < gaps.size(); ++i)
+      gaps[i] = 1 + static_cast<uint32_t>((i * 7919) % 61);
+
+    auto const report = [&](string const &name, auto const &encoded,
+                            auto const &decode) {
+      vector<uint32_t> decoded;
+      auto const elapsed = seconds([&]() { decoded = decode(encoded); });
+      cout << name << ": "
+           << static_cast<uint64_t>(gaps.size() / elapsed)
+           << " ints/s, lossless: " << (decoded == gaps) << endl;
+    };
+    report("Gamma", eopi::strings::elias_gamma_packed::encode(gaps),
+           eopi::strings::elias_gamma_packed::decode);
+    report("Delta", eopi::strings::elias_delta::encode(gaps),
+           eopi::strings::elias_delta::decode);
+    report("Rice", eopi::strings::golomb_rice::encode(gaps),
+           eopi::strings::golomb_rice::decode);
+    report("Varint", eopi::strings::varint::encode(gaps),
+           eopi::strings::varint::decode);
+
+    // block codecs over the same gaps as a sorted postings list
+    vector<uint32_t> postings(gaps.size());
+    uint32_t sum = 0;
+    for (size_t i = 0; i < gaps.size(); ++i)
+      postings[i] = sum += gaps[i];
+    auto const blocks = [&](string const &name, auto const &compressed) {
+      vector<uint32_t> decoded;
+      auto const elapsed = seconds([&]() { decoded = compressed.decode(); });
+      cout << name << ": "
+           << static_cast<uint64_t>(postings.size() / elapsed)
+           << " ints/s, lossless: " << (decoded == postings) << endl;
+    };
+    using eopi::strings::CompressedPostings;
+    blocks("FOR", CompressedPostings<eopi::strings::ForCodec>(postings));
+    blocks("PFOR", CompressedPostings<eopi::strings::PforCodec>(postings));
+    blocks("Stream VByte",
+           CompressedPostings<eopi::strings::StreamVByteCodec>(postings));
+    blocks("BP128", CompressedPostings<eopi::strings::Bp128Codec>(postings));
+  }
+
+  {
+    // lazily justify 10000 paragraphs from a stream into a buffered sink
+    string report;
+    for (size_t i = 0; i < 10000; ++i)
+      report += "Sed ut perspiciatis unde omnis iste natus error sit "
+                "voluptatem accusantium doloremque laudantium\n\n";
+    istringstream input(report);
+    ostringstream output;
+    auto const elapsed = seconds([&]() {
+      eopi::strings::justify_stream(
+          input, 40, eopi::strings::OstreamSink(output),
+          eopi::strings::Layout::minimum_raggedness);
+    });
+    cout << "Justify: "
+         << static_cast<uint64_t>(report.size() / elapsed / (1 << 20))
+         << " MiB/s" << endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+#ifndef EOPI_BENCHMARK_TIMING_HPP_
+#define EOPI_BENCHMARK_TIMING_HPP_
+
+#include <chrono>
+
+namespace eopi {
+namespace benchmark {
+
+// wall clock seconds of one call of f
+template <typename functor> double seconds(functor f) {
+  auto const start = std::chrono::steady_clock::now();
+  f();
+  std::chrono::duration<double> const elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+} // namespace benchmark
+} // namespace eopi
+
+#endif // EOPI_BENCHMARK_TIMING_HPP_
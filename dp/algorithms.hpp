@@ -4,345 +4,256 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <iostream>
+#include <limits>
 #include <numeric>
+#include <stdexcept>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
-namespace std {
-template <> struct hash<pair<uint32_t, uint32_t>> {
-  size_t operator()(pair<uint32_t, uint32_t> const &value) const {
-    return hash<uint32_t>()(value.first) ^ hash<uint32_t>()(value.second);
-  }
-};
-}
+#include "../parallel/chunks.hpp"
+#include "coin_change.hpp"
+#include "grid.hpp"
+#include "knapsack.hpp"
+#include "measure.hpp"
+#include "rectangle.hpp"
+#include "subarray.hpp"
+#include "subsequence.hpp"
 
 namespace eopi {
 namespace dp {
 namespace algorithms {
 
+// the combinations of 2, 3 and 7 point plays that reach final_score
 inline std::uint64_t football_combinations(std::int32_t final_score) {
-  std::vector<std::uint64_t> combinations(final_score + 1, 0);
-  std::vector<std::size_t> points = {2, 3, 7};
-  combinations[0] = 1;
-  for (auto p : points) {
-    for (std::size_t i = p; i < combinations.size(); ++i) {
-      combinations[i] += combinations[i - p];
-    }
-  }
-  return combinations.back();
+  if (final_score < 0)
+    return 0;
+  return coin_change_count({2, 3, 7},
+                           static_cast<std::uint64_t>(final_score));
 }
 
-inline std::uint32_t levenshtein_distance(std::string const &lhs,
-                                          std::string const &rhs) {
-  // go for minimum memory usage
-  if (rhs.size() > lhs.size())
-    return levenshtein_distance(rhs, lhs);
-
-  // Koenig swap
-  using std::swap;
-  // the previous row and the current row allow accessing the DP data, swapped
-  // for every row
-  std::vector<int> last_row(rhs.size() + 1, 0), current_row(rhs.size() + 1);
-  std::iota(last_row.begin(), last_row.end(), 0);
-  for (std::size_t i = 0; i < lhs.size(); ++i) {
-    current_row[0] = i;
-    for (std::size_t j = 0; j < rhs.size(); ++j) {
-      current_row[j + 1] =
-          std::min(last_row[j + 1] + 1, current_row[j - 1] + 1);
-      if (lhs[i] == rhs[j])
-        current_row[j + 1] = std::min(current_row[j + 1], last_row[j]);
-      else
-        current_row[j + 1] = std::min(current_row[j + 1], last_row[j]) + 1;
-    }
-    swap(last_row, current_row);
-  }
-
-  // the full edit distance is (due to the final swap) in the last_row, instead
-  // of the current_row
-  return last_row.back();
+namespace details {
+// one column step of Myers' bit-vector algorithm on a 64 row block (Hyyroe's
+// formulation). hin is the horizontal delta entering the top row of the
+// block, returns the delta leaving the row marked by high
+inline std::int32_t myers_block(std::uint64_t &pv, std::uint64_t &mv,
+                                std::uint64_t eq, std::int32_t const hin,
+                                std::uint64_t const high) {
+  auto const xv = eq | mv;
+  if (hin < 0)
+    eq |= 1;
+  auto const xh = (((eq & pv) + pv) ^ pv) | eq;
+  auto ph = mv | ~(xh | pv);
+  auto mh = pv & xh;
+  auto const hout = (ph & high) ? 1 : (mh & high) ? -1 : 0;
+  ph <<= 1;
+  mh <<= 1;
+  if (hin < 0)
+    mh |= 1;
+  else if (hin > 0)
+    ph |= 1;
+  pv = mh | ~(xv | ph);
+  mv = ph & xv;
+  return hout;
 }
 
-// find the most valuable trip through a 2d array going only down and right
-// (top_left == [0][0])
-inline std::uint32_t
-fishing_trip(std::vector<std::vector<std::int32_t>> const &values) {
-  // for reducing additional memory usage, we only remember the current row and
-  // the last row, since we need to go left and up in the DP
-  std::vector<std::uint32_t> last_row(values.size() + 1, 0),
-      current_row(values.size() + 1, 0);
+// edit distance in O(ceil(m / 64) * n) for a pattern of m and a text of n
+// bytes. Every bit of a block holds the vertical delta of one pattern row
+inline std::uint32_t myers_distance(std::string const &pattern,
+                                    std::string const &text) {
+  auto const m = pattern.size();
+  if (m == 0)
+    return static_cast<std::uint32_t>(text.size());
+
+  auto const blocks = (m + 63) / 64;
+  auto const last_high = std::uint64_t{1} << ((m - 1) % 64);
+  std::uint32_t score = static_cast<std::uint32_t>(m);
+
+  if (blocks == 1) {
+    std::uint64_t peq[256] = {};
+    for (std::size_t i = 0; i < m; ++i)
+      peq[static_cast<std::uint8_t>(pattern[i])] |= std::uint64_t{1} << i;
+    std::uint64_t pv = ~std::uint64_t{0}, mv = 0;
+    for (auto c : text)
+      score += myers_block(pv, mv, peq[static_cast<std::uint8_t>(c)], 1,
+                           last_high);
+    return score;
+  }
 
-  using std::swap;
-  // lower right is the desired value
-  for (std::size_t row = 0; row < values.size(); ++row) {
-    for (std::size_t col = 0; col < values[0].size(); ++col) {
-      current_row[col + 1] =
-          std::max(current_row[col], last_row[col + 1]) + values[row][col];
-    }
-    swap(last_row, current_row);
+  // peq[c * blocks + b]: rows of block b matching c
+  std::vector<std::uint64_t> peq(256 * blocks, 0);
+  for (std::size_t i = 0; i < m; ++i)
+    peq[static_cast<std::uint8_t>(pattern[i]) * blocks + i / 64] |=
+        std::uint64_t{1} << (i % 64);
+  std::vector<std::uint64_t> pv(blocks, ~std::uint64_t{0}), mv(blocks, 0);
+  for (auto c : text) {
+    auto const eq = peq.data() + static_cast<std::uint8_t>(c) * blocks;
+    std::int32_t carry = 1;
+    for (std::size_t b = 0; b + 1 < blocks; ++b)
+      carry = myers_block(pv[b], mv[b], eq[b], carry, std::uint64_t{1} << 63);
+    score += myers_block(pv[blocks - 1], mv[blocks - 1], eq[blocks - 1], carry,
+                         last_high);
   }
-  return last_row.back();
+  return score;
 }
+} // namespace details
 
-// compute the 0-1 knapsack problem, pseudopolinomial (capacity * |items|)
-inline std::uint32_t knapsack_zero_one(
-    std::vector<std::pair<std::uint32_t, std::uint32_t>> const &items,
-    std::uint32_t capacity) {
-  std::vector<std::uint32_t> values(capacity + 1, 0);
-
-  for (auto item : items) {
-    // weight > 0
-    for (std::size_t i = values.size() - 1; i >= item.second; --i) {
-      values[i] = std::max(values[i], values[i - item.second] + item.first);
-    }
-  }
-  return values.back();
+// edit distance with the bit-parallel algorithm of Myers, the shorter string
+// is the pattern
+inline std::uint32_t levenshtein_distance(std::string const &lhs,
+                                          std::string const &rhs) {
+  return lhs.size() <= rhs.size() ? details::myers_distance(lhs, rhs)
+                                  : details::myers_distance(rhs, lhs);
 }
 
-inline bool measure_helper(
-    std::unordered_set<std::pair<std::uint32_t, std::uint32_t>> &cache,
-    std::uint32_t min, std::uint32_t max) {
-  // already found to be not possible
-  if (cache.count(std::make_pair(min, max)))
+// whether the edit distance is at most k. Only the diagonal band of width
+// 2k + 1 of the DP is computed, rows are abandoned as soon as no entry within
+// the band is at most k
+inline bool levenshtein_within(std::string const &lhs, std::string const &rhs,
+                               std::uint32_t const k) {
+  auto const n = lhs.size(), m = rhs.size();
+  if ((n > m ? n - m : m - n) > k)
     return false;
-
-  if (min <= 230 && max >= 240) {
-    std::cout << "A";
+  // no distance exceeds the longer length, the band would only waste memory
+  if (k >= std::max(n, m))
     return true;
-  } else if (min <= 290 && max >= 310) {
-    std::cout << "B";
-    return true;
-  } else if (min <= 500 && max >= 515) {
-    std::cout << "C";
-    return true;
-  }
 
-  if (min > 230 && max > 240 && measure_helper(cache, min - 230, max - 240)) {
-    std::cout << "A";
-    return true;
-  }
-  if (min > 290 && max > 310 && measure_helper(cache, min - 290, max - 310)) {
-    std::cout << "B";
-    return true;
-  }
-  if (min > 500 && max > 515 && measure_helper(cache, min - 500, max - 515)) {
-    std::cout << "C";
-    return true;
-  }
+  // row[d] holds D[i][i + d - k], entries outside the DP are k + 1
+  auto const width = 2 * static_cast<std::size_t>(k) + 1;
+  auto const out = k + 1;
+  std::vector<std::uint32_t> last_row(width, out), current_row(width, out);
+  for (std::size_t d = k; d < width && d - k <= m; ++d)
+    last_row[d] = static_cast<std::uint32_t>(d - k);
 
-  // not possible
-  cache.insert(std::make_pair(min, max));
-  return false;
+  using std::swap;
+  for (std::size_t i = 1; i <= n; ++i) {
+    auto best = out;
+    for (std::size_t d = 0; d < width; ++d) {
+      auto const j = static_cast<std::ptrdiff_t>(i + d) - k;
+      std::uint32_t value = out;
+      if (j == 0) {
+        value = static_cast<std::uint32_t>(i);
+      } else if (j > 0 && static_cast<std::size_t>(j) <= m) {
+        value = last_row[d] + (lhs[i - 1] != rhs[j - 1] ? 1 : 0);
+        if (d + 1 < width)
+          value = std::min(value, last_row[d + 1] + 1);
+        if (d > 0)
+          value = std::min(value, current_row[d - 1] + 1);
+        value = std::min(value, out);
+      }
+      current_row[d] = value;
+      best = std::min(best, value);
+    }
+    if (best > k)
+      return false;
+    swap(last_row, current_row);
+  }
+  return last_row[m + k - n] <= k;
 }
 
-inline bool measure(std::uint32_t min, std::uint32_t max) {
-  std::unordered_set<std::pair<std::uint32_t, std::uint32_t>> cache;
-  auto res = measure_helper(cache, min, max);
-  if (res)
-    std::cout << std::endl;
-  return res;
+// find the most valuable trip through a 2d array going only down and right
+// (top_left == [0][0]). Sequentially only one line along the smaller
+// dimension is kept, with multiple threads the table is filled in parallel
+// wavefronts of tiles
+inline std::uint32_t
+fishing_trip(std::vector<std::vector<std::int32_t>> const &values,
+             std::uint32_t const threads = 1) {
+  auto const rows = values.size(), cols = rows ? values[0].size() : 0;
+  if (threads <= 1)
+    return sweep<std::uint32_t>(
+        rows, cols, 0,
+        [&](std::size_t row, std::size_t col, std::uint32_t up,
+            std::uint32_t left, std::uint32_t) {
+          return std::max(up, left) + values[row][col];
+        });
+
+  Grid<std::uint32_t> yield(rows, cols);
+  wavefront(rows, cols, 64, threads,
+            [&](std::size_t row_begin, std::size_t row_end,
+                std::size_t col_begin, std::size_t col_end) {
+              for (auto row = row_begin; row < row_end; ++row)
+                for (auto col = col_begin; col < col_end; ++col)
+                  yield(row, col) =
+                      std::max(row ? yield(row - 1, col) : 0,
+                               col ? yield(row, col - 1) : 0) +
+                      values[row][col];
+            });
+  return rows && cols ? yield(rows - 1, cols - 1) : 0;
 }
 
-// in contrast to the linear case, we need to walk through the array twice. In
-// addition to the best value, we also track the current length. If the length
-// is > n, there is a positive loop and no optimum exists (infinite optimum)
-inline std::uint64_t
-max_subarray_sum_cyclic(std::vector<std::int32_t> const &values) {
-  std::uint64_t prev = 0;
-  std::uint64_t length = 0;
-  std::uint64_t best = 0;
-
-  for (std::size_t i = 0; i < 2 * values.size(); ++i) {
-    auto val = values[i % values.size()];
-    // we summed the full array
-    if (length >= values.size()) {
-      do {
-        val -= values[i - length];
-        --length;
-        // skip over all negatives as well
-      } while (length && values[i - length] < 0);
-    }
-    if (val >= 0 || static_cast<std::uint64_t>(std::abs(val)) < prev) {
-      prev += val;
-      length++;
-      best = std::max(best, prev);
-    } else {
-      // total sum becomes negative, start a new sequence
-      prev = 0;
-      length = 0;
-    }
+namespace details {
+inline std::uint64_t gcd(std::uint64_t a, std::uint64_t b) {
+  while (b) {
+    auto const rest = a % b;
+    a = b;
+    b = rest;
   }
-  return best;
+  return a;
 }
 
-inline std::uint64_t critical_case_helper(
-    std::unordered_map<std::pair<std::uint32_t, std::uint32_t>, std::uint64_t>
-        &cache,
-    std::uint32_t const cases, std::uint32_t const drops) {
-  // base cases
-  if (cases == 1)
-    return drops;
-  if (cases == 0 || drops == 0)
-    return 0;
-
-  auto params = std::make_pair(cases, drops);
-  auto itr = cache.find(params);
-  if (itr != cache.end())
-    return itr->second;
-
-  cache[params] = critical_case_helper(cache, cases - 1, drops - 1) + 1 +
-                  critical_case_helper(cache, cases, drops - 1);
-  return cache[params];
+// a * b, or false if it does not fit
+inline bool multiply(std::uint64_t const a, std::uint64_t const b,
+                     std::uint64_t &product) {
+  return !__builtin_mul_overflow(a, b, &product);
 }
+} // namespace details
 
+// the number of floors among which the critical floor can be found with the
+// given number of cases and drops. Bottom up, F(k, d) = F(k - 1, d - 1) + 1 +
+// F(k, d - 1) sums to the binomials C(d, 1) + ... + C(d, k), computed in
+// O(min(k, d)). Saturates at the largest std::uint64_t
 inline std::uint64_t critical_case(std::uint32_t const cases,
                                    std::uint32_t const drops) {
-  std::unordered_map<std::pair<std::uint32_t, std::uint32_t>, std::uint64_t>
-      cache;
-  return critical_case_helper(cache, cases, drops);
-}
-
-inline std::uint32_t max_coin_gain_helper(
-    std::vector<std::uint32_t> const &values,
-    std::unordered_map<std::pair<std::uint32_t, std::uint32_t>, std::uint64_t>
-        &cache,
-    std::size_t begin, std::size_t end, std::uint64_t total_sum) {
-  // if only a single coin is left, it is the gain
-  if (begin + 1 == end)
-    return values[begin];
-
-  auto params = std::make_pair(begin, end);
-  if (cache.count(params))
-    return cache[params];
-
-  cache[params] =
-      std::max((total_sum - max_coin_gain_helper(values, cache, begin + 1, end,
-                                                 total_sum - values[begin])),
-               (total_sum - max_coin_gain_helper(values, cache, begin, end - 1,
-                                                 total_sum - values[end - 1])));
-
-  return cache[params];
-}
-
-inline std::uint32_t max_coin_gain(std::vector<std::uint32_t> const &values) {
-  std::unordered_map<std::pair<std::uint32_t, std::uint32_t>, std::uint64_t>
-      cache;
-  auto total = std::accumulate(values.begin(), values.end(), 0);
-  auto max_profit =
-      max_coin_gain_helper(values, cache, 0, values.size(), total);
-  std::cout << "Total: " << total << " Profit: " << max_profit << std::endl;
-  return 2 * max_profit - total;
-}
-
-// find a non-decreasing subsequence (A_i <= A_j for i < j) within data
-inline std::vector<std::int32_t>
-longest_nondecreasing_subsequence(std::vector<std::int32_t> const &data) {
-  // for every possible length, remember the smallest possible tail
-  std::vector<std::int32_t> tails;
-  // the positions of the tails within the array
-  std::vector<std::int32_t> positions;
-  // for every data entry, we remember the previous entry if it is part of our
-  // list of tails
-  std::vector<std::int32_t> parents(data.size(), -1);
-  for (std::size_t i = 0; i < data.size(); ++i) {
-    auto itr = std::upper_bound(tails.begin(), tails.end(), data[i]);
-    if (itr == tails.end()) {
-      if (!tails.empty()) {
-        parents[i] = tails.back();
-      }
-      positions.push_back(i);
-      tails.push_back(data[i]);
-    } else {
-      auto pos = std::distance(tails.begin(), itr);
-      if (itr != tails.begin()) {
-        parents[i] = positions[pos - 1];
-      }
-      *itr = data[i];
-      positions[pos] = i;
-    }
-  }
-  std::vector<std::int32_t> result;
-  auto cur = positions.back();
-  while (cur != -1) {
-    result.push_back(data[cur]);
-    cur = parents[cur];
+  auto const saturated = std::numeric_limits<std::uint64_t>::max();
+  std::uint64_t floors = 0, binomial = 1;
+  for (std::uint64_t i = 1; i <= std::min(cases, drops); ++i) {
+    // C(d, i) = C(d, i - 1) * (d - i + 1) / i, dividing before multiplying
+    auto const divisor = details::gcd(binomial, i);
+    if (!details::multiply(binomial / divisor, (drops - i + 1) / (i / divisor),
+                           binomial) ||
+        floors > saturated - binomial)
+      return saturated;
+    floors += binomial;
   }
-  std::reverse(result.begin(), result.end());
-  return result;
+  return floors;
 }
 
-// compute the maximum sub-array that is all set to true
-inline std::tuple<std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t>
-max_subarray(std::vector<std::vector<bool>> const &field,
-             const bool quadratic) {
-  // for every element of the array, compute the number of 1s to the left/under
-  // of a position
-  std::vector<std::vector<std::uint32_t>> left_of(
-      field.size(), std::vector<std::uint32_t>(field[0].size(), 0));
-  std::vector<std::vector<std::uint32_t>> under_of(
-      field.size(), std::vector<std::uint32_t>(field[0].size(), 0));
-
-  for (std::size_t row = 0; row < field.size(); ++row) {
-    for (std::size_t col = 0; col < field[0].size(); ++col) {
-      if (field[row][col]) {
-        left_of[row][col] = under_of[row][col] = 1;
-        if (col > 0)
-          left_of[row][col] += left_of[row][col - 1];
-        if (row > 0)
-          under_of[row][col] += under_of[row - 1][col];
-      }
-      // if the field is 0, no length array starts here and the initialisation
-      // is already correct
-    }
-  }
-
-  std::vector<std::vector<std::pair<std::uint32_t, std::uint32_t>>> max_size(
-      field.size(),
-      std::vector<std::pair<std::uint32_t, std::uint32_t>>(field[0].size()));
-
-  for (std::size_t row = 0; row < field.size(); ++row) {
-    for (std::size_t col = 0; col < field[row].size(); ++col) {
-      if (!field[row][col])
-        continue;
-
-      if (quadratic) {
-        auto size = std::min(under_of[row][col], left_of[row][col]);
-        if (row > 0 && col > 0)
-          size = std::min(max_size[row - 1][col - 1].first + 1, size);
-        max_size[row][col] = std::make_pair(size, size);
-      } else {
-        std::uint32_t max_height = under_of[row][col];
-        for (std::size_t i = 0; i <= col && max_height > 0; ++i) {
-          max_height = std::min(under_of[row][col - i], max_height);
-          auto size = max_height * (i + 1);
-          if (size > max_size[row][col].first * max_size[row][col].second) {
-            max_size[row][col] = std::make_pair(max_height, i + 1);
-          }
-        }
-      }
-    }
-  }
-
-  // find the maximum over all arrays
-  std::uint32_t best_row = 0, best_col = 0, best = 0;
-
-  for (std::size_t row = 0; row < field.size(); ++row) {
-    for (std::size_t col = 0; col < field[0].size(); ++col) {
-      auto cur = max_size[row][col].first * max_size[row][col].second;
-      if (cur > best) {
-        best_row = row;
-        best_col = col;
-        best = cur;
-      }
-    }
+// the fewest drops that find the critical floor among `floors` floors, a
+// binary search over critical_case in O(k log n)
+inline std::uint32_t minimum_drops(std::uint32_t const cases,
+                                   std::uint32_t const floors) {
+  if (cases == 0 && floors > 0)
+    throw std::out_of_range("No cases to drop");
+  std::uint32_t low = 0, high = floors;
+  while (low < high) {
+    auto const mid = low + (high - low) / 2;
+    if (critical_case(cases, mid) >= floors)
+      high = mid;
+    else
+      low = mid + 1;
   }
+  return low;
+}
 
-  return {best_row - max_size[best_row][best_col].first + 1,
-          best_col - max_size[best_row][best_col].second + 1, best_row,
-          best_col};
+// players alternately take a coin from either end, returns how much more the
+// first player collects when both play optimally. The best gain of the player
+// to move on values[begin, begin + length) is the sum of the range minus the
+// best gain of the opponent on what is left, so a single row over the start
+// of the range is updated for every length
+inline std::uint32_t max_coin_gain(std::vector<std::uint32_t> const &values) {
+  auto const n = values.size();
+  std::vector<std::uint64_t> prefix(n + 1, 0);
+  for (std::size_t i = 0; i < n; ++i)
+    prefix[i + 1] = prefix[i] + values[i];
+
+  std::vector<std::uint64_t> gain(values.begin(), values.end());
+  for (std::size_t length = 2; length <= n; ++length)
+    for (std::size_t begin = 0; begin + length <= n; ++begin)
+      gain[begin] = prefix[begin + length] - prefix[begin] -
+                    std::min(gain[begin], gain[begin + 1]);
+
+  auto const max_profit = n ? gain[0] : 0;
+  return static_cast<std::uint32_t>(2 * max_profit - prefix[n]);
 }
 
 } // namespace algorithms
@@ -0,0 +1,220 @@
+#ifndef EOPI_DP_COIN_CHANGE_HPP_
+#define EOPI_DP_COIN_CHANGE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace eopi {
+namespace dp {
+namespace algorithms {
+
+// a residue modulo `modulus`, to count ways that overflow every integer type
+template <std::uint32_t modulus> class Modular {
+public:
+  Modular(std::uint64_t const value = 0)
+      : residue(static_cast<std::uint32_t>(value % modulus)) {}
+
+  std::uint32_t value() const { return residue; }
+
+  Modular &operator+=(Modular const &other) {
+    residue = static_cast<std::uint32_t>(
+        (std::uint64_t{residue} + other.residue) % modulus);
+    return *this;
+  }
+
+  Modular &operator-=(Modular const &other) {
+    residue = static_cast<std::uint32_t>(
+        (std::uint64_t{residue} + modulus - other.residue) % modulus);
+    return *this;
+  }
+
+  friend Modular operator+(Modular lhs, Modular const &rhs) {
+    return lhs += rhs;
+  }
+
+  friend Modular operator-(Modular lhs, Modular const &rhs) {
+    return lhs -= rhs;
+  }
+
+  friend Modular operator*(Modular const &lhs, Modular const &rhs) {
+    return Modular(std::uint64_t{lhs.residue} * rhs.residue);
+  }
+
+  friend bool operator==(Modular const &lhs, Modular const &rhs) {
+    return lhs.residue == rhs.residue;
+  }
+
+  friend std::ostream &operator<<(std::ostream &out, Modular const &value) {
+    return out << value.residue;
+  }
+
+private:
+  std::uint32_t residue;
+};
+
+// combinations count every multiset of coins once (2 + 3 equals 3 + 2),
+// sequences count every order of the coins separately
+enum class CoinOrder { combinations, sequences };
+
+namespace details {
+inline void check_coins(std::vector<std::uint32_t> const &coins) {
+  if (std::find(coins.begin(), coins.end(), 0u) != coins.end())
+    throw std::invalid_argument("Coin values must be positive");
+}
+
+// the recurrence a_n = sum of e_j * a_{n - j} for n >= 1 (a_n = 0 for n < 0)
+// as the nonzero terms (j, e_j). The generating function of the ways is
+// 1 / D(x), with D(x) the product of (1 - x^c) over the coins for
+// combinations and 1 - (the sum of x^c) for sequences, so e_j = -[x^j] D(x)
+inline std::vector<std::pair<std::size_t, std::int64_t>>
+coin_recurrence(std::vector<std::uint32_t> const &coins,
+                CoinOrder const order) {
+  std::vector<std::int64_t> d = {1};
+  for (auto coin : coins) {
+    if (order == CoinOrder::combinations) {
+      d.resize(d.size() + coin, 0);
+      for (auto j = d.size(); j-- > coin;)
+        d[j] -= d[j - coin];
+    } else {
+      d.resize(std::max<std::size_t>(d.size(), coin + 1), 0);
+      d[coin] -= 1;
+    }
+  }
+  std::vector<std::pair<std::size_t, std::int64_t>> terms;
+  for (std::size_t j = 1; j < d.size(); ++j)
+    if (d[j])
+      terms.emplace_back(j, -d[j]);
+  return terms;
+}
+
+// the count type holding |value|, built from ones by doubling so any type
+// constructible from 0 and 1 works
+template <typename count_type> count_type to_count(std::uint64_t const value) {
+  count_type result(0);
+  for (auto bit = std::uint64_t{1} << 63; bit; bit >>= 1) {
+    result += result;
+    if (value & bit)
+      result += count_type(1);
+  }
+  return result;
+}
+
+// Kitamasa: x^score modulo the characteristic polynomial of the recurrence
+// gives a_score as a combination of a_0 .. a_{order - 1}, by squaring in
+// O(order^2 log score)
+template <typename count_type>
+count_type
+kitamasa(std::vector<std::pair<std::size_t, std::int64_t>> const &terms,
+         std::vector<count_type> const &initial, std::uint64_t const score) {
+  auto const order = initial.size();
+  std::vector<count_type> factors;
+  for (auto const &term : terms)
+    factors.push_back(to_count<count_type>(
+        static_cast<std::uint64_t>(term.second < 0 ? -term.second
+                                                   : term.second)));
+
+  // p mod (x^order - sum of e_j x^(order - j)), from the top down
+  auto const reduce = [&](std::vector<count_type> &p) {
+    for (auto k = p.size(); k-- > order;) {
+      for (std::size_t t = 0; t < terms.size(); ++t) {
+        if (terms[t].second < 0)
+          p[k - terms[t].first] -= factors[t] * p[k];
+        else
+          p[k - terms[t].first] += factors[t] * p[k];
+      }
+      p[k] = count_type(0);
+    }
+    p.resize(order, count_type(0));
+  };
+
+  // x^0, then one bit of the score at a time from the top
+  std::vector<count_type> power(order, count_type(0));
+  power[0] = count_type(1);
+  auto bit = std::uint64_t{1} << 63;
+  while (bit > score)
+    bit >>= 1;
+  for (; bit; bit >>= 1) {
+    std::vector<count_type> square(2 * order - 1, count_type(0));
+    for (std::size_t i = 0; i < order; ++i)
+      for (std::size_t j = 0; j < order; ++j)
+        square[i + j] += power[i] * power[j];
+    if (score & bit)
+      square.insert(square.begin(), count_type(0));
+    reduce(square);
+    power.swap(square);
+  }
+
+  count_type result(0);
+  for (std::size_t i = 0; i < order; ++i)
+    result += power[i] * initial[i];
+  return result;
+}
+} // namespace details
+
+// the ways to reach every score in [0,score] with unlimited coins of the
+// given values, O(score * |coins|)
+template <typename count_type = std::uint64_t>
+std::vector<count_type>
+coin_change_table(std::vector<std::uint32_t> const &coins,
+                  std::uint32_t const score,
+                  CoinOrder const order = CoinOrder::combinations) {
+  details::check_coins(coins);
+  std::vector<count_type> ways(std::size_t{score} + 1, count_type(0));
+  ways[0] = count_type(1);
+  if (order == CoinOrder::combinations) {
+    for (auto coin : coins)
+      for (std::size_t i = coin; i < ways.size(); ++i)
+        ways[i] += ways[i - coin];
+  } else {
+    for (std::size_t i = 1; i < ways.size(); ++i)
+      for (auto coin : coins)
+        if (coin <= i)
+          ways[i] += ways[i - coin];
+  }
+  return ways;
+}
+
+// the ways to reach score. Small scores fill the table, large ones follow the
+// linear recurrence of order S in O(S^2 log score), where S is the sum of the
+// coins (combinations) or the largest coin (sequences). Large scores need a
+// count type with -= as the recurrence has negative terms
+template <typename count_type = std::uint64_t>
+count_type coin_change_count(std::vector<std::uint32_t> const &coins,
+                             std::uint64_t const score,
+                             CoinOrder const order = CoinOrder::combinations) {
+  details::check_coins(coins);
+  if (coins.empty())
+    return count_type(score == 0 ? 1 : 0);
+
+  std::uint64_t dimension = 0;
+  for (auto coin : coins)
+    dimension = order == CoinOrder::combinations
+                    ? dimension + coin
+                    : std::max<std::uint64_t>(dimension, coin);
+  auto const terms = details::coin_recurrence(coins, order);
+  std::uint64_t bits = 0;
+  for (auto rest = score; rest; rest >>= 1)
+    ++bits;
+  auto const table_cost = static_cast<double>(score) * coins.size();
+  auto const power_cost = static_cast<double>(bits) *
+                          static_cast<double>(dimension) *
+                          static_cast<double>(dimension + terms.size());
+  if (score < (std::uint64_t{1} << 32) && table_cost <= power_cost)
+    return coin_change_table<count_type>(
+               coins, static_cast<std::uint32_t>(score), order)
+        .back();
+
+  auto const initial = coin_change_table<count_type>(
+      coins, static_cast<std::uint32_t>(dimension - 1), order);
+  return details::kitamasa(terms, initial, score);
+}
+
+} // namespace algorithms
+} // namespace dp
+} // namespace eopi
+
+#endif // EOPI_DP_COIN_CHANGE_HPP_
@@ -0,0 +1,332 @@
+#ifndef EOPI_DP_FUZZY_SEARCH_HPP_
+#define EOPI_DP_FUZZY_SEARCH_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "../parallel/chunks.hpp"
+#include "algorithms.hpp"
+
+namespace eopi {
+namespace dp {
+namespace algorithms {
+
+// (distance, index of the candidate)
+using Match = std::pair<std::uint32_t, std::size_t>;
+
+namespace details {
+// a query of at most 64 bytes, preprocessed for Myers' algorithm
+struct MyersQuery {
+  explicit MyersQuery(std::string const &query)
+      : peq(), high(std::uint64_t{1} << ((query.size() + 63) % 64)),
+        size(static_cast<std::uint32_t>(query.size())) {
+    for (std::size_t i = 0; i < query.size(); ++i)
+      peq[static_cast<std::uint8_t>(query[i])] |= std::uint64_t{1} << i;
+  }
+
+  std::uint64_t peq[256];
+  std::uint64_t high;
+  std::uint32_t size;
+};
+
+// distances of the query to up to four texts, one text per vector lane
+inline void myers_lanes(MyersQuery const &query,
+                        std::string const *const *texts,
+                        std::size_t const lanes, std::uint32_t *distances) {
+  std::size_t length = 0;
+  for (std::size_t lane = 0; lane < lanes; ++lane)
+    length = std::max(length, texts[lane]->size());
+
+#if defined(__AVX2__)
+  auto const ones = _mm256_set1_epi64x(-1);
+  auto const high = _mm256_set1_epi64x(static_cast<long long>(query.high));
+  auto pv = ones, mv = _mm256_setzero_si256();
+  auto score = _mm256_set1_epi64x(query.size);
+  for (std::size_t pos = 0; pos < length; ++pos) {
+    // lanes past the end of their text keep their score
+    long long eq[4] = {}, active[4] = {};
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+      if (pos < texts[lane]->size()) {
+        eq[lane] = static_cast<long long>(
+            query.peq[static_cast<std::uint8_t>((*texts[lane])[pos])]);
+        active[lane] = -1;
+      }
+    }
+    auto const e = _mm256_setr_epi64x(eq[0], eq[1], eq[2], eq[3]);
+    auto const a =
+        _mm256_setr_epi64x(active[0], active[1], active[2], active[3]);
+
+    auto const xv = _mm256_or_si256(e, mv);
+    auto const sum = _mm256_add_epi64(_mm256_and_si256(e, pv), pv);
+    auto const xh = _mm256_or_si256(_mm256_xor_si256(sum, pv), e);
+    auto ph = _mm256_or_si256(
+        mv, _mm256_andnot_si256(_mm256_or_si256(xh, pv), ones));
+    auto mh = _mm256_and_si256(pv, xh);
+
+    // compares yield -1 for set bits, so subtracting counts up
+    auto const up = _mm256_cmpeq_epi64(_mm256_and_si256(ph, high), high);
+    auto const down = _mm256_cmpeq_epi64(_mm256_and_si256(mh, high), high);
+    score = _mm256_sub_epi64(score, _mm256_and_si256(up, a));
+    score = _mm256_add_epi64(score, _mm256_and_si256(down, a));
+
+    ph = _mm256_or_si256(_mm256_slli_epi64(ph, 1), _mm256_set1_epi64x(1));
+    mh = _mm256_slli_epi64(mh, 1);
+    pv = _mm256_or_si256(
+        mh, _mm256_andnot_si256(_mm256_or_si256(xv, ph), ones));
+    mv = _mm256_and_si256(ph, xv);
+  }
+  long long scores[4];
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(scores), score);
+  for (std::size_t lane = 0; lane < lanes; ++lane)
+    distances[lane] = static_cast<std::uint32_t>(scores[lane]);
+#else
+  (void)length;
+  for (std::size_t lane = 0; lane < lanes; ++lane) {
+    std::uint64_t pv = ~std::uint64_t{0}, mv = 0;
+    auto score = query.size;
+    for (auto c : *texts[lane])
+      score += myers_block(pv, mv, query.peq[static_cast<std::uint8_t>(c)], 1,
+                           query.high);
+    distances[lane] = score;
+  }
+#endif
+}
+
+// distance of the query to every candidate in order, four at a time
+template <typename functor>
+void distances_in_lanes(std::string const &query,
+                        std::vector<std::string const *> const &candidates,
+                        functor on_distance) {
+  if (query.size() > 64) {
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+      on_distance(i, myers_distance(query, *candidates[i]));
+    return;
+  }
+  MyersQuery const prepared(query);
+  std::uint32_t distances[4];
+  for (std::size_t i = 0; i < candidates.size(); i += 4) {
+    auto const lanes = std::min<std::size_t>(4, candidates.size() - i);
+    if (query.empty()) {
+      for (std::size_t lane = 0; lane < lanes; ++lane)
+        distances[lane] =
+            static_cast<std::uint32_t>(candidates[i + lane]->size());
+    } else {
+      myers_lanes(prepared, candidates.data() + i, lanes, distances);
+    }
+    for (std::size_t lane = 0; lane < lanes; ++lane)
+      on_distance(i + lane, distances[lane]);
+  }
+}
+
+// keeps the k smallest matches, ties broken by the smaller index
+class TopK {
+public:
+  explicit TopK(std::size_t const k) : k(k) {}
+
+  // no match with a distance of at least bound can enter anymore
+  std::uint32_t bound() const {
+    if (heap.size() < k)
+      return std::numeric_limits<std::uint32_t>::max();
+    return heap.empty() ? 0 : heap.top().first;
+  }
+
+  void push(Match const &match) {
+    if (heap.size() < k) {
+      heap.push(match);
+    } else if (k && match < heap.top()) {
+      heap.pop();
+      heap.push(match);
+    }
+  }
+
+  std::vector<Match> sorted() {
+    std::vector<Match> result;
+    for (; !heap.empty(); heap.pop())
+      result.push_back(heap.top());
+    std::reverse(result.begin(), result.end());
+    return result;
+  }
+
+private:
+  std::size_t k;
+  std::priority_queue<Match> heap;
+};
+
+inline std::uint32_t length_difference(std::size_t const lhs,
+                                       std::size_t const rhs) {
+  return static_cast<std::uint32_t>(lhs > rhs ? lhs - rhs : rhs - lhs);
+}
+} // namespace details
+
+// edit distances of query to all candidates. Queries of up to 64 bytes are
+// scored against four candidates at once (one per AVX2 lane), candidates of
+// similar length are grouped to keep the lanes busy
+inline std::vector<std::uint32_t>
+levenshtein_batch(std::string const &query,
+                  std::vector<std::string> const &candidates,
+                  std::uint32_t const threads = parallel::default_threads()) {
+  std::vector<std::uint32_t> distances(candidates.size());
+  parallel::for_each_chunk(
+      candidates.size(), threads,
+      [&](std::uint32_t, std::size_t const begin, std::size_t const end) {
+        std::vector<std::size_t> order(end - begin);
+        std::iota(order.begin(), order.end(), begin);
+        std::sort(order.begin(), order.end(), [&](auto lhs, auto rhs) {
+          return candidates[lhs].size() < candidates[rhs].size();
+        });
+        std::vector<std::string const *> texts;
+        texts.reserve(order.size());
+        for (auto index : order)
+          texts.push_back(&candidates[index]);
+        details::distances_in_lanes(
+            query, texts, [&](std::size_t const i, std::uint32_t const d) {
+              distances[order[i]] = d;
+            });
+      });
+  return distances;
+}
+
+// the k candidates closest to query as (distance, index), sorted by distance
+// and index. Candidates whose length difference alone exceeds the current
+// k-th best distance are skipped without being scored
+inline std::vector<Match>
+closest_words(std::string const &query,
+              std::vector<std::string> const &candidates, std::size_t const k,
+              std::uint32_t const threads = parallel::default_threads()) {
+  std::vector<std::vector<Match>> partial(std::max(1u, threads));
+  parallel::for_each_chunk(
+      candidates.size(), threads,
+      [&](std::uint32_t const chunk, std::size_t const begin,
+          std::size_t const end) {
+        details::TopK best(k);
+        std::vector<std::size_t> group;
+        std::vector<std::string const *> texts;
+        auto const score = [&]() {
+          details::distances_in_lanes(
+              query, texts, [&](std::size_t const i, std::uint32_t const d) {
+                best.push({d, group[i]});
+              });
+          group.clear();
+          texts.clear();
+        };
+        for (auto i = begin; i < end; ++i) {
+          if (details::length_difference(query.size(), candidates[i].size()) >=
+              best.bound())
+            continue;
+          group.push_back(i);
+          texts.push_back(&candidates[i]);
+          if (group.size() == 4)
+            score();
+        }
+        score();
+        partial[chunk] = best.sorted();
+      });
+
+  details::TopK best(k);
+  for (auto const &matches : partial)
+    for (auto const &match : matches)
+      best.push(match);
+  return best.sorted();
+}
+
+// a trie over a dictionary, searched with one DP row per trie node. Subtrees
+// whose row minimum exceeds the current k-th best distance are pruned, so
+// words sharing a prefix share the work of scoring it
+class WordTrie {
+public:
+  enum : std::size_t { NONE = std::numeric_limits<std::size_t>::max() };
+
+  WordTrie() : nodes(1), depth(0) {}
+
+  explicit WordTrie(std::vector<std::string> const &words) : WordTrie() {
+    for (std::size_t i = 0; i < words.size(); ++i)
+      insert(words[i], i);
+  }
+
+  // a word inserted more than once keeps its first index
+  void insert(std::string const &word, std::size_t const index) {
+    std::uint32_t node = 0;
+    for (auto c : word) {
+      auto &children = nodes[node].children;
+      auto itr =
+          std::find_if(children.begin(), children.end(),
+                       [c](auto const &child) { return child.first == c; });
+      if (itr == children.end()) {
+        children.emplace_back(c, static_cast<std::uint32_t>(nodes.size()));
+        node = children.back().second;
+        nodes.emplace_back();
+      } else {
+        node = itr->second;
+      }
+    }
+    if (nodes[node].word == NONE)
+      nodes[node].word = index;
+    depth = std::max(depth, word.size());
+  }
+
+  std::vector<Match> closest(std::string const &query,
+                             std::size_t const k) const {
+    details::TopK best(k);
+    // one row per trie depth, reused by all nodes of that depth
+    std::vector<std::vector<std::uint32_t>> rows(
+        depth + 1, std::vector<std::uint32_t>(query.size() + 1));
+    std::iota(rows[0].begin(), rows[0].end(), 0);
+    if (nodes[0].word != NONE)
+      best.push({rows[0].back(), nodes[0].word});
+    search(0, 0, query, rows, best);
+    return best.sorted();
+  }
+
+private:
+  struct Node {
+    Node() : word(NONE) {}
+
+    std::vector<std::pair<char, std::uint32_t>> children;
+    std::size_t word;
+  };
+
+  void search(std::uint32_t const node, std::size_t const level,
+              std::string const &query,
+              std::vector<std::vector<std::uint32_t>> &rows,
+              details::TopK &best) const {
+    auto const &last_row = rows[level];
+    auto &row = rows[level + 1];
+    for (auto const &child : nodes[node].children) {
+      row[0] = static_cast<std::uint32_t>(level + 1);
+      auto minimum = row[0];
+      for (std::size_t j = 1; j <= query.size(); ++j) {
+        row[j] = std::min({last_row[j] + 1, row[j - 1] + 1,
+                           last_row[j - 1] +
+                               (query[j - 1] != child.first ? 1 : 0)});
+        minimum = std::min(minimum, row[j]);
+      }
+
+      auto const &next = nodes[child.second];
+      if (next.word != NONE)
+        best.push({row.back(), next.word});
+      // ties may still enter with a smaller index
+      if (minimum <= best.bound() && !next.children.empty())
+        search(child.second, level + 1, query, rows, best);
+    }
+  }
+
+  std::vector<Node> nodes;
+  std::size_t depth;
+};
+
+} // namespace algorithms
+} // namespace dp
+} // namespace eopi
+
+#endif // EOPI_DP_FUZZY_SEARCH_HPP_
@@ -0,0 +1,143 @@
+#ifndef EOPI_DP_GRID_HPP_
+#define EOPI_DP_GRID_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../parallel/chunks.hpp"
+
+namespace eopi {
+namespace dp {
+
+// a row major table stored in one contiguous block
+template <typename value_type> class Grid {
+public:
+  Grid(std::size_t const rows, std::size_t const cols,
+       value_type const &value = value_type())
+      : row_count(rows), col_count(cols), cells(rows * cols, value) {}
+
+  value_type &operator()(std::size_t const row, std::size_t const col) {
+    return cells[row * col_count + col];
+  }
+
+  value_type const &operator()(std::size_t const row,
+                               std::size_t const col) const {
+    return cells[row * col_count + col];
+  }
+
+  std::size_t rows() const { return row_count; }
+  std::size_t cols() const { return col_count; }
+
+private:
+  std::size_t row_count;
+  std::size_t col_count;
+  std::vector<value_type> cells;
+};
+
+// a row major bit table, every row padded to whole 64 bit words. Bits past
+// the last column are always clear
+class BitMatrix {
+public:
+  BitMatrix(std::size_t const rows, std::size_t const cols)
+      : row_count(rows), col_count(cols), word_count((cols + 63) / 64),
+        bits(rows * word_count, 0) {}
+
+  explicit BitMatrix(std::vector<std::vector<bool>> const &field)
+      : BitMatrix(field.size(), field.empty() ? 0 : field[0].size()) {
+    for (std::size_t row = 0; row < row_count; ++row)
+      for (std::size_t col = 0; col < col_count; ++col)
+        if (field[row][col])
+          set(row, col);
+  }
+
+  bool operator()(std::size_t const row, std::size_t const col) const {
+    return (bits[row * word_count + col / 64] >> (col % 64)) & 1;
+  }
+
+  void set(std::size_t const row, std::size_t const col,
+           bool const value = true) {
+    auto &word = bits[row * word_count + col / 64];
+    auto const mask = std::uint64_t{1} << (col % 64);
+    word = value ? word | mask : word & ~mask;
+  }
+
+  std::uint64_t const *row(std::size_t const row) const {
+    return bits.data() + row * word_count;
+  }
+
+  std::uint64_t *row(std::size_t const row) {
+    return bits.data() + row * word_count;
+  }
+
+  std::size_t rows() const { return row_count; }
+  std::size_t cols() const { return col_count; }
+  std::size_t words() const { return word_count; }
+
+private:
+  std::size_t row_count;
+  std::size_t col_count;
+  std::size_t word_count;
+  std::vector<std::uint64_t> bits;
+};
+
+// Tiled wavefront over a rows x cols table whose cells depend on their upper,
+// left and upper left neighbours. Calls kernel(row_begin, row_end, col_begin,
+// col_end) for every tile after the tiles above and to the left of it. The
+// tiles of one anti-diagonal are independent and run in parallel; within a
+// tile the kernel visits the rows top to bottom, every row left to right.
+template <typename functor>
+void wavefront(std::size_t const rows, std::size_t const cols,
+               std::size_t const tile, std::uint32_t const threads,
+               functor kernel) {
+  if (rows == 0 || cols == 0)
+    return;
+  auto const tile_rows = (rows + tile - 1) / tile;
+  auto const tile_cols = (cols + tile - 1) / tile;
+  for (std::size_t diagonal = 0; diagonal < tile_rows + tile_cols - 1;
+       ++diagonal) {
+    auto const first = diagonal < tile_cols ? 0 : diagonal - tile_cols + 1;
+    auto const last = std::min(diagonal, tile_rows - 1);
+    parallel::for_each_chunk(
+        last - first + 1, threads,
+        [&](std::uint32_t, std::size_t const begin, std::size_t const end) {
+          for (auto t = first + begin; t < first + end; ++t) {
+            auto const col = diagonal - t;
+            kernel(t * tile, std::min(rows, (t + 1) * tile), col * tile,
+                   std::min(cols, (col + 1) * tile));
+          }
+        });
+  }
+}
+
+// Evaluates D(row, col) = cell(row, col, up, left, diagonal) over a rows x
+// cols table, where neighbours outside the table are boundary. Only one line
+// along the smaller dimension is kept, returns D(rows - 1, cols - 1)
+template <typename value_type, typename functor>
+value_type sweep(std::size_t const rows, std::size_t const cols,
+                 value_type const boundary, functor cell) {
+  if (rows == 0 || cols == 0)
+    return boundary;
+
+  // line[i + 1] holds the previous value along the line, line[0] the boundary
+  auto const by_rows = cols <= rows;
+  std::vector<value_type> line((by_rows ? cols : rows) + 1, boundary);
+  auto const outer = by_rows ? rows : cols, inner = by_rows ? cols : rows;
+  for (std::size_t i = 0; i < outer; ++i) {
+    auto diagonal = boundary;
+    for (std::size_t j = 0; j < inner; ++j) {
+      auto const previous = line[j + 1], before = line[j];
+      line[j + 1] =
+          by_rows ? cell(i, j, previous, before, diagonal)
+                  : cell(j, i, before, previous, diagonal);
+      diagonal = previous;
+    }
+  }
+  return line.back();
+}
+
+} // namespace dp
+} // namespace eopi
+
+#endif // EOPI_DP_GRID_HPP_
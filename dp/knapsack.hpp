@@ -0,0 +1,392 @@
+#ifndef EOPI_DP_KNAPSACK_HPP_
+#define EOPI_DP_KNAPSACK_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../parallel/barrier.hpp"
+#include "../parallel/chunks.hpp"
+
+namespace eopi {
+namespace dp {
+namespace algorithms {
+
+// (value, weight)
+using KnapsackItem = std::pair<std::uint32_t, std::uint32_t>;
+
+// dense is the O(n * capacity) table, optionally sliced over threads.
+// subset_sum needs value == weight for every item and shifts a bitset in
+// O(n * capacity / 64). meet_in_the_middle enumerates both halves of the
+// items in O(2^(n/2)), pruning subsets over the capacity, so its cost does
+// not grow with the capacity
+enum class KnapsackMode { automatic, dense, subset_sum, meet_in_the_middle };
+
+// the most items meet_in_the_middle accepts, each half lists up to 2^20
+// subsets
+enum : std::size_t { MEET_IN_THE_MIDDLE_ITEMS = 40 };
+
+struct KnapsackSolution {
+  std::uint64_t value;
+  // indices of the chosen items, increasing
+  std::vector<std::size_t> items;
+};
+
+namespace details {
+// items that can matter, weight 0 items are always taken and the capacity
+// never exceeds the total weight
+struct KnapsackProblem {
+  std::vector<KnapsackItem> items;
+  std::vector<std::size_t> index;
+  std::vector<std::size_t> free_items;
+  std::uint64_t free_value;
+  std::uint32_t capacity;
+  bool unit_values;
+};
+
+inline KnapsackProblem prepare_knapsack(std::vector<KnapsackItem> const &items,
+                                        std::uint32_t const capacity) {
+  KnapsackProblem problem{{}, {}, {}, 0, 0, true};
+  std::uint64_t total = 0;
+  for (std::size_t i = 0; i < items.size(); ++i) {
+    if (items[i].first == 0 || items[i].second > capacity)
+      continue;
+    if (items[i].second == 0) {
+      problem.free_items.push_back(i);
+      problem.free_value += items[i].first;
+      continue;
+    }
+    problem.items.push_back(items[i]);
+    problem.index.push_back(i);
+    problem.unit_values &= items[i].first == items[i].second;
+    total += items[i].second;
+  }
+  problem.capacity =
+      static_cast<std::uint32_t>(std::min<std::uint64_t>(capacity, total));
+  return problem;
+}
+
+// best[c]: the best value of items[begin,end) within capacity c
+inline std::vector<std::uint32_t>
+dense_profile(std::vector<KnapsackItem> const &items, std::size_t const begin,
+              std::size_t const end, std::uint32_t const capacity,
+              std::uint32_t const threads) {
+  std::vector<std::uint32_t> best(std::size_t{capacity} + 1, 0);
+  if (threads <= 1 || (end - begin) * best.size() < (std::size_t{1} << 22)) {
+    for (auto i = begin; i < end; ++i) {
+      auto const value = items[i].first, weight = items[i].second;
+      for (auto c = capacity; c >= weight; --c)
+        best[c] = std::max(best[c], best[c - weight] + value);
+    }
+    return best;
+  }
+
+  // every thread owns a slice of the capacities, rows alternate between two
+  // buffers and the threads meet after every item
+  std::vector<std::uint32_t> next(best.size());
+  auto const chunks = static_cast<std::uint32_t>(
+      std::min<std::size_t>(threads, best.size()));
+  parallel::Barrier barrier(chunks);
+  parallel::for_each_chunk(
+      best.size(), chunks,
+      [&](std::uint32_t, std::size_t const low, std::size_t const high) {
+        auto *from = best.data(), *to = next.data();
+        for (auto i = begin; i < end; ++i) {
+          auto const value = items[i].first;
+          auto const weight = std::min<std::size_t>(items[i].second, high);
+          auto c = low;
+          for (; c < weight; ++c)
+            to[c] = from[c];
+          for (; c < high; ++c)
+            to[c] = std::max(from[c], from[c - items[i].second] + value);
+          barrier.wait();
+          std::swap(from, to);
+        }
+      });
+  if ((end - begin) % 2)
+    best.swap(next);
+  return best;
+}
+
+// splits the capacity between both halves of the items where the best values
+// add up to the optimum, so only two profiles are alive per level
+inline void dense_items(std::vector<KnapsackItem> const &items,
+                        std::size_t const begin, std::size_t const end,
+                        std::uint32_t const capacity,
+                        std::uint32_t const threads,
+                        std::vector<std::size_t> &chosen) {
+  if (begin == end || capacity == 0)
+    return;
+  if (end - begin == 1) {
+    if (items[begin].second <= capacity)
+      chosen.push_back(begin);
+    return;
+  }
+  auto const mid = begin + (end - begin) / 2;
+  auto const left = dense_profile(items, begin, mid, capacity, threads);
+  auto const right = dense_profile(items, mid, end, capacity, threads);
+  std::uint32_t split = 0;
+  std::uint64_t best = 0;
+  for (std::uint32_t c = 0; c <= capacity; ++c) {
+    auto const value = std::uint64_t{left[c]} + right[capacity - c];
+    if (value > best) {
+      best = value;
+      split = c;
+    }
+  }
+  dense_items(items, begin, mid, split, threads, chosen);
+  dense_items(items, mid, end, capacity - split, threads, chosen);
+}
+
+// bits |= bits << shift
+inline void shift_or(std::uint64_t *bits, std::size_t const words,
+                     std::size_t const shift) {
+  auto const word_shift = shift / 64, bit_shift = shift % 64;
+  for (auto i = words; i-- > word_shift;) {
+    auto value = bits[i - word_shift] << bit_shift;
+    if (bit_shift && i > word_shift)
+      value |= bits[i - word_shift - 1] >> (64 - bit_shift);
+    bits[i] |= value;
+  }
+}
+
+inline bool test_bit(std::vector<std::uint64_t> const &bits,
+                     std::size_t const pos) {
+  return (bits[pos / 64] >> (pos % 64)) & 1;
+}
+
+// bit s is set iff some subset of items[begin,end) weighs exactly s
+inline std::vector<std::uint64_t>
+subset_profile(std::vector<KnapsackItem> const &items, std::size_t const begin,
+               std::size_t const end, std::uint32_t const capacity) {
+  auto const size = std::size_t{capacity} + 1;
+  auto const tail =
+      size % 64 ? (std::uint64_t{1} << (size % 64)) - 1 : ~std::uint64_t{0};
+  std::vector<std::uint64_t> bits((size + 63) / 64, 0);
+  bits[0] = 1;
+  for (auto i = begin; i < end; ++i) {
+    if (items[i].second > capacity)
+      continue;
+    shift_or(bits.data(), bits.size(), items[i].second);
+    bits.back() &= tail;
+  }
+  return bits;
+}
+
+// the largest reachable weight
+inline std::uint32_t highest_bit(std::vector<std::uint64_t> const &bits) {
+  for (auto i = bits.size(); i-- > 0;)
+    if (bits[i])
+      return static_cast<std::uint32_t>(
+          i * 64 + 63 - static_cast<std::size_t>(__builtin_clzll(bits[i])));
+  return 0;
+}
+
+// a subset of items[begin,end) weighing exactly target, found by splitting
+// the target between both halves like dense_items
+inline void subset_items(std::vector<KnapsackItem> const &items,
+                         std::size_t const begin, std::size_t const end,
+                         std::uint32_t const target,
+                         std::vector<std::size_t> &chosen) {
+  if (target == 0)
+    return;
+  if (end - begin == 1) {
+    chosen.push_back(begin);
+    return;
+  }
+  auto const mid = begin + (end - begin) / 2;
+  auto const left = subset_profile(items, begin, mid, target);
+  auto const right = subset_profile(items, mid, end, target);
+  for (std::uint32_t s = 0; s <= target; ++s) {
+    if (test_bit(left, s) && test_bit(right, target - s)) {
+      subset_items(items, begin, mid, s, chosen);
+      subset_items(items, mid, end, target - s, chosen);
+      return;
+    }
+  }
+}
+
+struct Subset {
+  std::uint64_t weight;
+  std::uint64_t value;
+  std::uint64_t mask;
+};
+
+// all subsets of items[begin,end) within the capacity, sorted by weight. Every
+// item merges the list with a shifted copy of itself, so no sort is needed
+inline std::vector<Subset> subsets(std::vector<KnapsackItem> const &items,
+                                   std::size_t const begin,
+                                   std::size_t const end,
+                                   std::uint32_t const capacity) {
+  std::vector<Subset> all = {{0, 0, 0}}, with, merged;
+  for (auto i = begin; i < end; ++i) {
+    with.clear();
+    for (auto const &subset : all) {
+      auto const weight = subset.weight + items[i].second;
+      if (weight > capacity)
+        break;
+      with.push_back({weight, subset.value + items[i].first,
+                      subset.mask | (std::uint64_t{1} << (i - begin))});
+    }
+    merged.resize(all.size() + with.size());
+    std::merge(all.begin(), all.end(), with.begin(), with.end(),
+               merged.begin(), [](Subset const &lhs, Subset const &rhs) {
+                 return lhs.weight < rhs.weight;
+               });
+    all.swap(merged);
+  }
+  return all;
+}
+
+inline void meet_in_the_middle(std::vector<KnapsackItem> const &items,
+                               std::uint32_t const capacity,
+                               std::vector<std::size_t> &chosen) {
+  auto const mid = items.size() / 2;
+  auto const left = subsets(items, 0, mid, capacity);
+  auto const all_right = subsets(items, mid, items.size(), capacity);
+  // the lightest subset for every better value, values then grow with weight
+  std::vector<Subset> right;
+  for (auto const &subset : all_right)
+    if (right.empty() || subset.value > right.back().value)
+      right.push_back(subset);
+
+  // heavier left subsets leave less room, so the right pointer only drops
+  Subset best_left = left[0], best_right = right[0];
+  auto j = right.size();
+  for (auto const &subset : left) {
+    while (right[j - 1].weight > capacity - subset.weight)
+      --j;
+    if (subset.value + right[j - 1].value >
+        best_left.value + best_right.value) {
+      best_left = subset;
+      best_right = right[j - 1];
+    }
+  }
+  for (std::size_t i = 0; i < mid; ++i)
+    if ((best_left.mask >> i) & 1)
+      chosen.push_back(i);
+  for (auto i = mid; i < items.size(); ++i)
+    if ((best_right.mask >> (i - mid)) & 1)
+      chosen.push_back(i);
+}
+
+inline KnapsackMode choose_mode(KnapsackProblem const &problem) {
+  auto const n = static_cast<double>(problem.items.size());
+  auto const cells = n * (static_cast<double>(problem.capacity) + 1);
+  auto mode = KnapsackMode::dense;
+  auto cost = cells;
+  if (problem.unit_values) {
+    mode = KnapsackMode::subset_sum;
+    cost = cells / 64;
+  }
+  // both halves are merged once per item, keep the lists in memory
+  if (problem.items.size() <= MEET_IN_THE_MIDDLE_ITEMS) {
+    auto const half = std::uint64_t{1} << ((problem.items.size() + 1) / 2);
+    if (4.0 * static_cast<double>(half) < cost)
+      mode = KnapsackMode::meet_in_the_middle;
+  }
+  return mode;
+}
+
+inline KnapsackSolution solve_knapsack(std::vector<KnapsackItem> const &items,
+                                       std::uint32_t const capacity,
+                                       KnapsackMode mode,
+                                       std::uint32_t const threads,
+                                       bool const reconstruct) {
+  auto const problem = prepare_knapsack(items, capacity);
+  if (mode == KnapsackMode::automatic)
+    mode = choose_mode(problem);
+
+  KnapsackSolution solution{problem.free_value, problem.free_items};
+  std::vector<std::size_t> chosen;
+  auto const &kept = problem.items;
+  std::uint64_t total = 0;
+  for (auto const &item : kept)
+    total += item.second;
+  if (total <= problem.capacity) {
+    // everything fits
+    chosen.resize(kept.size());
+    for (std::size_t i = 0; i < kept.size(); ++i) {
+      chosen[i] = i;
+      solution.value += kept[i].first;
+    }
+    mode = KnapsackMode::automatic;
+  }
+  switch (mode) {
+  case KnapsackMode::automatic:
+    break;
+  case KnapsackMode::subset_sum: {
+    if (!problem.unit_values)
+      throw std::invalid_argument("Subset sum needs value == weight");
+    auto const target =
+        highest_bit(subset_profile(kept, 0, kept.size(), problem.capacity));
+    solution.value += target;
+    if (reconstruct)
+      subset_items(kept, 0, kept.size(), target, chosen);
+    break;
+  }
+  case KnapsackMode::meet_in_the_middle:
+    if (kept.size() > MEET_IN_THE_MIDDLE_ITEMS)
+      throw std::out_of_range("Too many items to meet in the middle");
+    meet_in_the_middle(kept, problem.capacity, chosen);
+    for (auto i : chosen)
+      solution.value += kept[i].first;
+    break;
+  default:
+    if (reconstruct) {
+      dense_items(kept, 0, kept.size(), problem.capacity, threads, chosen);
+      for (auto i : chosen)
+        solution.value += kept[i].first;
+    } else {
+      solution.value +=
+          dense_profile(kept, 0, kept.size(), problem.capacity, threads)
+              .back();
+    }
+  }
+
+  if (reconstruct) {
+    for (auto i : chosen)
+      solution.items.push_back(problem.index[i]);
+    std::sort(solution.items.begin(), solution.items.end());
+  } else {
+    solution.items.clear();
+  }
+  return solution;
+}
+} // namespace details
+
+// the mode knapsack picks for the items and capacity
+inline KnapsackMode knapsack_mode(std::vector<KnapsackItem> const &items,
+                                  std::uint32_t const capacity) {
+  return details::choose_mode(details::prepare_knapsack(items, capacity));
+}
+
+// 0-1 knapsack with the chosen items. Reconstruction splits the capacity
+// between halves of the items recursively (Hirschberg), so it needs the
+// memory of two profiles instead of a table of n * capacity decisions
+inline KnapsackSolution
+knapsack(std::vector<KnapsackItem> const &items, std::uint32_t const capacity,
+         KnapsackMode const mode = KnapsackMode::automatic,
+         std::uint32_t const threads = parallel::default_threads()) {
+  return details::solve_knapsack(items, capacity, mode, threads, true);
+}
+
+// compute the 0-1 knapsack problem, pseudopolinomial (capacity * |items|)
+// unless a cheaper mode fits the items
+inline std::uint32_t knapsack_zero_one(std::vector<KnapsackItem> const &items,
+                                       std::uint32_t capacity,
+                                       std::uint32_t const threads = 1) {
+  return static_cast<std::uint32_t>(
+      details::solve_knapsack(items, capacity, KnapsackMode::automatic,
+                              threads, false)
+          .value);
+}
+
+} // namespace algorithms
+} // namespace dp
+} // namespace eopi
+
+#endif // EOPI_DP_KNAPSACK_HPP_
@@ -0,0 +1,140 @@
+#ifndef EOPI_DP_MEASURE_HPP_
+#define EOPI_DP_MEASURE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace eopi {
+namespace dp {
+namespace algorithms {
+
+// a cup that measures some volume within [low, high]
+using Cup = std::pair<std::uint32_t, std::uint32_t>;
+
+// Which totals can be measured with any number of fills of the given cups so
+// that the result is guaranteed to lie within [min, max]? A combination works
+// iff its lows add up to at least min and its highs to at most max.
+//
+// Only the largest low sum matters for every high sum: every fill raises the
+// high sum, so max_low[high] is the best max_low[high - cup high] + cup low
+// over the cups, filled bottom up. The running maximum of max_low answers any
+// query in O(1). Filling stops at the first high sum whose running maximum
+// reaches min_bound, as no query needs a larger one, so the table grows with
+// min_bound rather than max_bound
+class MeasureTable {
+public:
+  MeasureTable(std::vector<Cup> cups, std::uint32_t const min_bound,
+               std::uint32_t const max_bound)
+      : cups(std::move(cups)), min_bound(min_bound), max_bound(max_bound),
+        max_low(1, 0), best_low(1, NONE) {
+    std::uint32_t largest = 0;
+    bool grows = false;
+    for (auto const &cup : this->cups) {
+      if (cup.second == 0 || cup.first > cup.second)
+        throw std::invalid_argument("Cups need 0 <= low <= high, high > 0");
+      largest = std::max(largest, cup.second);
+      grows |= cup.first > 0;
+    }
+
+    // max_low[0] is the empty combination, never an answer on its own. Without
+    // a positive low every reachable low sum is 0, so nothing changes past
+    // the largest cup
+    for (std::uint64_t high = 1; high <= max_bound && !reaches(min_bound);
+         ++high) {
+      if (!grows && high > largest)
+        break;
+      std::uint32_t low = NONE;
+      for (auto const &cup : this->cups) {
+        if (cup.second > high || max_low[high - cup.second] == NONE)
+          continue;
+        auto const extended = max_low[high - cup.second] + cup.first;
+        if (low == NONE || extended > low)
+          low = extended;
+      }
+      max_low.push_back(low);
+      best_low.push_back(best_low.back());
+      if (low != NONE && (best_low.back() == NONE || low > best_low.back()))
+        best_low.back() = low;
+    }
+  }
+
+  bool feasible(std::uint32_t const min, std::uint32_t const max) const {
+    check(min, max);
+    auto const best = best_low[std::min<std::size_t>(max, filled())];
+    return best != NONE && best >= min;
+  }
+
+  // the indices of the cups to fill, in order, empty if min and max cannot be
+  // met. The running maximum never decreases, so a binary search finds the
+  // smallest high sum meeting min, then the walk back follows cups that
+  // extend the best low sum below
+  std::vector<std::size_t> combination(std::uint32_t const min,
+                                       std::uint32_t const max) const {
+    std::vector<std::size_t> result;
+    if (!feasible(min, max))
+      return result;
+    auto const first = std::partition_point(
+        best_low.begin() + 1,
+        best_low.begin() + std::min<std::size_t>(max, filled()) + 1,
+        [&](std::uint32_t const best) { return best == NONE || best < min; });
+    for (auto high = static_cast<std::size_t>(first - best_low.begin());
+         high;) {
+      for (std::size_t c = 0; c < cups.size(); ++c) {
+        auto const &cup = cups[c];
+        if (cup.second <= high && max_low[high - cup.second] != NONE &&
+            max_low[high - cup.second] + cup.first == max_low[high]) {
+          result.push_back(c);
+          high -= cup.second;
+          break;
+        }
+      }
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+  }
+
+private:
+  enum : std::uint32_t { NONE = 0xFFFFFFFF };
+
+  void check(std::uint32_t const min, std::uint32_t const max) const {
+    if (min > min_bound || max > max_bound)
+      throw std::out_of_range("Query outside of the measure table");
+  }
+
+  bool reaches(std::uint32_t const min) const {
+    return best_low.back() != NONE && best_low.back() >= min;
+  }
+
+  std::size_t filled() const { return max_low.size() - 1; }
+
+  std::vector<Cup> cups;
+  std::uint32_t min_bound;
+  std::uint32_t max_bound;
+  // the largest low sum of a combination with every high sum, or NONE
+  std::vector<std::uint32_t> max_low;
+  // the largest low sum among the high sums up to every value, or NONE
+  std::vector<std::uint32_t> best_low;
+};
+
+// the cups of the classic puzzle, A measures [230,240], B [290,310] and C
+// [500,515]. Prints the cups that reach [min,max]
+inline bool measure(std::uint32_t min, std::uint32_t max) {
+  MeasureTable const table({{230, 240}, {290, 310}, {500, 515}}, min, max);
+  auto const cups = table.combination(min, max);
+  for (auto cup : cups)
+    std::cout << static_cast<char>('A' + cup);
+  if (!cups.empty())
+    std::cout << std::endl;
+  return !cups.empty();
+}
+
+} // namespace algorithms
+} // namespace dp
+} // namespace eopi
+
+#endif // EOPI_DP_MEASURE_HPP_
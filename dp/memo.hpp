@@ -0,0 +1,91 @@
+#ifndef EOPI_DP_MEMO_HPP_
+#define EOPI_DP_MEMO_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace eopi {
+namespace dp {
+
+// the memo key of a DP state over two parameters
+inline std::uint64_t memo_key(std::uint32_t const first,
+                              std::uint32_t const second) {
+  return (std::uint64_t{first} << 32) | second;
+}
+
+// open addressing memo cache for sparse DP states. Every key is stored next to
+// its value in one flat array probed linearly, so a lookup touches one or two
+// cache lines instead of chasing the buckets of a node based map. The all ones
+// key is reserved.
+template <typename value_type> class FlatMemo {
+public:
+  enum : std::uint64_t { EMPTY = std::numeric_limits<std::uint64_t>::max() };
+
+  explicit FlatMemo(std::size_t const expected = 64) : count(0) {
+    std::size_t capacity = 16;
+    while (capacity < 2 * expected)
+      capacity *= 2;
+    slots.assign(capacity, Slot{EMPTY, value_type()});
+  }
+
+  // the cached value, or nullptr
+  value_type const *find(std::uint64_t const key) const {
+    auto const &slot = slots[probe(key)];
+    return slot.key == key ? &slot.value : nullptr;
+  }
+
+  bool contains(std::uint64_t const key) const {
+    return find(key) != nullptr;
+  }
+
+  void insert(std::uint64_t const key, value_type const &value) {
+    auto slot = probe(key);
+    if (slots[slot].key != key) {
+      // at most half full
+      if (2 * (count + 1) > slots.size()) {
+        grow();
+        slot = probe(key);
+      }
+      slots[slot].key = key;
+      ++count;
+    }
+    slots[slot].value = value;
+  }
+
+  std::size_t size() const { return count; }
+
+private:
+  struct Slot {
+    std::uint64_t key;
+    value_type value;
+  };
+
+  // the slot holding key, or the empty slot where it belongs
+  std::size_t probe(std::uint64_t const key) const {
+    auto const mask = slots.size() - 1;
+    // Fibonacci hashing spreads neighbouring states over the table
+    auto slot = static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) &
+                mask;
+    while (slots[slot].key != key && slots[slot].key != EMPTY)
+      slot = (slot + 1) & mask;
+    return slot;
+  }
+
+  void grow() {
+    std::vector<Slot> old(2 * slots.size(), Slot{EMPTY, value_type()});
+    old.swap(slots);
+    for (auto const &entry : old)
+      if (entry.key != EMPTY)
+        slots[probe(entry.key)] = entry;
+  }
+
+  std::size_t count;
+  std::vector<Slot> slots;
+};
+
+} // namespace dp
+} // namespace eopi
+
+#endif // EOPI_DP_MEMO_HPP_
@@ -0,0 +1,228 @@
+#ifndef EOPI_DP_RECTANGLE_HPP_
+#define EOPI_DP_RECTANGLE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../parallel/chunks.hpp"
+#include "grid.hpp"
+
+namespace eopi {
+namespace dp {
+namespace algorithms {
+
+// an all true rectangle as (top, left, bottom, right)
+using Rectangle =
+    std::tuple<std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t>;
+
+namespace details {
+// the best rectangle so far by its bottom right corner. Larger areas win, then
+// corners that come first in row major order, then taller rectangles, so the
+// winner does not depend on the order rectangles are offered in
+struct RectangleBest {
+  std::uint64_t area;
+  std::uint32_t height, width, row, col;
+
+  void update(std::uint32_t const h, std::uint32_t const w,
+              std::uint32_t const r, std::uint32_t const c) {
+    auto const size = std::uint64_t{h} * w;
+    if (size > area ||
+        (size == area && std::make_pair(r, c) < std::make_pair(row, col)) ||
+        (size == area && r == row && c == col && h > height))
+      *this = {size, h, w, r, c};
+  }
+
+  void update(RectangleBest const &other) {
+    if (other.area)
+      update(other.height, other.width, other.row, other.col);
+  }
+
+  Rectangle rectangle() const {
+    return Rectangle{row - height + 1, col - width + 1, row, col};
+  }
+};
+
+// the run of trues ending in every column after one more packed row. Whole
+// words of false reset and whole words of true count up without looking at
+// single bits, mixed words mask every height with its bit
+inline void raise_heights(std::uint32_t *heights, std::uint64_t const *bits,
+                          std::size_t const cols) {
+  for (std::size_t word = 0; word * 64 < cols; ++word) {
+    auto *h = heights + word * 64;
+    auto const count = std::min<std::size_t>(64, cols - word * 64);
+    auto const full = count == 64 ? ~std::uint64_t{0}
+                                  : (std::uint64_t{1} << count) - 1;
+    auto const value = bits[word] & full;
+    if (value == 0) {
+      std::fill(h, h + count, 0u);
+    } else if (value == full) {
+      for (std::size_t i = 0; i < count; ++i)
+        ++h[i];
+    } else {
+      for (std::size_t i = 0; i < count; ++i)
+        h[i] = (h[i] + 1) & (0u - static_cast<std::uint32_t>(value >> i & 1));
+    }
+  }
+}
+} // namespace details
+
+// The largest all true rectangle of a raster pushed one packed row at a time,
+// in O(cols) memory. Every row updates the histogram of runs ending in it and
+// a stack of rising bars finds the widest rectangle under every bar, O(cols)
+// per row
+class LargestRectangle {
+public:
+  explicit LargestRectangle(std::size_t const cols)
+      : LargestRectangle(std::vector<std::uint32_t>(cols, 0), 0) {}
+
+  // continues below rows that left the given runs in every column
+  LargestRectangle(std::vector<std::uint32_t> heights,
+                   std::size_t const first_row)
+      : heights(std::move(heights)), row(first_row),
+        best(details::RectangleBest{0, 0, 0, 0, 0}) {
+    bars.reserve(this->heights.size() + 1);
+  }
+
+  // a row of (cols + 63) / 64 words, column c in bit c % 64 of word c / 64
+  void push_row(std::uint64_t const *bits) {
+    details::raise_heights(heights.data(), bits, heights.size());
+    scan();
+    ++row;
+  }
+
+  void push_row(std::vector<bool> const &values) {
+    std::vector<std::uint64_t> bits((values.size() + 63) / 64, 0);
+    for (std::size_t col = 0; col < values.size(); ++col)
+      if (values[col])
+        bits[col / 64] |= std::uint64_t{1} << (col % 64);
+    push_row(bits.data());
+  }
+
+  std::uint64_t area() const { return best.area; }
+
+  // the winner among equally large rectangles has the bottom right corner
+  // that comes first in row major order
+  Rectangle result() const { return best.rectangle(); }
+
+  details::RectangleBest const &summary() const { return best; }
+
+private:
+  struct Bar {
+    std::uint32_t start, height;
+  };
+
+  // every bar taller than the next column ends at the previous one and spans
+  // back to where it started rising
+  void scan() {
+    auto const cols = heights.size();
+    bars.clear();
+    for (std::size_t col = 0; col <= cols; ++col) {
+      auto const height = col < cols ? heights[col] : 0u;
+      auto start = static_cast<std::uint32_t>(col);
+      while (!bars.empty() && bars.back().height > height) {
+        auto const bar = bars.back();
+        bars.pop_back();
+        best.update(bar.height, static_cast<std::uint32_t>(col) - bar.start,
+                    static_cast<std::uint32_t>(row),
+                    static_cast<std::uint32_t>(col - 1));
+        start = bar.start;
+      }
+      if (height && (bars.empty() || bars.back().height < height))
+        bars.push_back({start, height});
+    }
+  }
+
+  std::vector<std::uint32_t> heights;
+  std::size_t row;
+  details::RectangleBest best;
+  std::vector<Bar> bars;
+};
+
+// the largest all true rectangle of a packed field in O(rows * cols). More
+// threads split the rows into bands: the runs that leave every band chain
+// into the heights entering the next, then every band scans on its own
+inline Rectangle max_subarray(BitMatrix const &field,
+                              std::uint32_t const threads = 1) {
+  auto const rows = field.rows(), cols = field.cols();
+  if (threads <= 1 || rows < 2 * std::size_t{threads}) {
+    LargestRectangle scanner(cols);
+    for (std::size_t row = 0; row < rows; ++row)
+      scanner.push_row(field.row(row));
+    return scanner.result();
+  }
+
+  auto const bands = threads;
+  std::vector<std::vector<std::uint32_t>> runs(
+      bands, std::vector<std::uint32_t>(cols, 0));
+  parallel::for_each_chunk(rows, bands,
+                           [&](std::uint32_t band, std::size_t begin,
+                               std::size_t end) {
+                             for (auto row = begin; row < end; ++row)
+                               details::raise_heights(runs[band].data(),
+                                                      field.row(row), cols);
+                           });
+
+  // a column that is true all through a band carries the heights above it on
+  std::vector<std::vector<std::uint32_t>> entering(
+      bands, std::vector<std::uint32_t>(cols, 0));
+  for (std::uint32_t band = 1; band < bands; ++band) {
+    auto const above = parallel::chunk_range(rows, bands, band - 1);
+    auto const span = static_cast<std::uint32_t>(above.second - above.first);
+    for (std::size_t col = 0; col < cols; ++col)
+      entering[band][col] =
+          runs[band - 1][col] +
+          (runs[band - 1][col] == span ? entering[band - 1][col] : 0);
+  }
+
+  std::vector<details::RectangleBest> partial(
+      bands, details::RectangleBest{0, 0, 0, 0, 0});
+  parallel::for_each_chunk(
+      rows, bands,
+      [&](std::uint32_t band, std::size_t begin, std::size_t end) {
+        LargestRectangle scanner(std::move(entering[band]), begin);
+        for (auto row = begin; row < end; ++row)
+          scanner.push_row(field.row(row));
+        partial[band] = scanner.summary();
+      });
+  for (std::uint32_t band = 1; band < bands; ++band)
+    partial[0].update(partial[band]);
+  return partial[0].rectangle();
+}
+
+// compute the maximum sub-array that is all set to true, as (top, left,
+// bottom, right), either the largest square or the largest rectangle. Among
+// equally large sub-arrays the one whose bottom right corner comes first in
+// row major order wins
+inline Rectangle max_subarray(std::vector<std::vector<bool>> const &field,
+                              const bool quadratic,
+                              std::uint32_t const threads = 1) {
+  if (!quadratic)
+    return max_subarray(BitMatrix(field), threads);
+
+  auto const rows = field.size(), cols = rows ? field[0].size() : 0;
+  details::RectangleBest best = {0, 0, 0, 0, 0};
+  // the largest square ending in a cell grows the smallest of its neighbours
+  // by one, the table is never materialised
+  sweep<std::uint32_t>(rows, cols, 0,
+                       [&](std::size_t row, std::size_t col, std::uint32_t up,
+                           std::uint32_t left, std::uint32_t diagonal) {
+                         if (!field[row][col])
+                           return 0u;
+                         auto const size = std::min({up, left, diagonal}) + 1;
+                         best.update(size, size,
+                                     static_cast<std::uint32_t>(row),
+                                     static_cast<std::uint32_t>(col));
+                         return size;
+                       });
+  return best.rectangle();
+}
+
+} // namespace algorithms
+} // namespace dp
+} // namespace eopi
+
+#endif // EOPI_DP_RECTANGLE_HPP_
@@ -0,0 +1,196 @@
+#ifndef EOPI_DP_SUBARRAY_HPP_
+#define EOPI_DP_SUBARRAY_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "../parallel/chunks.hpp"
+
+namespace eopi {
+namespace dp {
+namespace algorithms {
+
+// Kadane state of a range, empty prefixes, suffixes and subarrays included.
+// Ranges combine associatively, so the summaries of adjacent chunks reduce in
+// any grouping
+struct SubarraySummary {
+  std::int64_t sum;
+  std::int64_t max_prefix, max_suffix, max_best;
+  std::int64_t min_prefix, min_suffix, min_best;
+
+  static SubarraySummary of(std::int64_t const value) {
+    auto const high = std::max<std::int64_t>(0, value);
+    auto const low = std::min<std::int64_t>(0, value);
+    return {value, high, high, high, low, low, low};
+  }
+
+  // the range followed by next
+  SubarraySummary then(SubarraySummary const &next) const {
+    return {sum + next.sum,
+            std::max(max_prefix, sum + next.max_prefix),
+            std::max(next.max_suffix, next.sum + max_suffix),
+            std::max({max_best, next.max_best, max_suffix + next.max_prefix}),
+            std::min(min_prefix, sum + next.min_prefix),
+            std::min(next.min_suffix, next.sum + min_suffix),
+            std::min({min_best, next.min_best, min_suffix + next.min_prefix})};
+  }
+
+  // a wrapping subarray is the total minus a minimum subarray
+  std::int64_t cyclic_best() const {
+    return std::max(max_best, sum - min_best);
+  }
+};
+
+namespace details {
+// summary of values from the prefix sums P: the best subarray ending at j is
+// P_j minus the smallest earlier prefix sum, the worst P_j minus the largest
+inline SubarraySummary summarise(std::int32_t const *values,
+                                 std::size_t const size) {
+  std::int64_t prefix = 0, low = 0, high = 0, best = 0, worst = 0;
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  auto sums = _mm256_setzero_si256(), lows = sums, highs = sums;
+  auto bests = sums, worsts = sums;
+  auto const max64 = [](__m256i a, __m256i b) {
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(b, a));
+  };
+  auto const min64 = [](__m256i a, __m256i b) {
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+  };
+  for (; i + 4 <= size; i += 4) {
+    auto x = _mm256_cvtepi32_epi64(
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(values + i)));
+    // inclusive scan within the vector: shift by one lane, then by two
+    x = _mm256_add_epi64(
+        x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x90),
+                              _mm256_setzero_si256(), 0x03));
+    x = _mm256_add_epi64(
+        x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x40),
+                              _mm256_setzero_si256(), 0x0F));
+    auto const p = _mm256_add_epi64(x, sums);
+
+    // running extremes of the prefix sums, repeating lanes is harmless
+    auto lo = min64(p, _mm256_permute4x64_epi64(p, 0x90));
+    lo = min64(lo, _mm256_permute4x64_epi64(lo, 0x40));
+    lo = min64(lo, lows);
+    auto hi = max64(p, _mm256_permute4x64_epi64(p, 0x90));
+    hi = max64(hi, _mm256_permute4x64_epi64(hi, 0x40));
+    hi = max64(hi, highs);
+
+    bests = max64(bests, _mm256_sub_epi64(p, lo));
+    worsts = min64(worsts, _mm256_sub_epi64(p, hi));
+    sums = _mm256_permute4x64_epi64(p, 0xFF);
+    lows = _mm256_permute4x64_epi64(lo, 0xFF);
+    highs = _mm256_permute4x64_epi64(hi, 0xFF);
+  }
+  alignas(32) std::int64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), bests);
+  best = *std::max_element(lanes, lanes + 4);
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), worsts);
+  worst = *std::min_element(lanes, lanes + 4);
+  prefix = _mm256_extract_epi64(sums, 0);
+  low = _mm256_extract_epi64(lows, 0);
+  high = _mm256_extract_epi64(highs, 0);
+#endif
+  for (; i < size; ++i) {
+    prefix += values[i];
+    low = std::min(low, prefix);
+    high = std::max(high, prefix);
+    best = std::max(best, prefix - low);
+    worst = std::min(worst, prefix - high);
+  }
+  return {prefix, high, prefix - low, best, low, prefix - high, worst};
+}
+} // namespace details
+
+// Kadane summary of values, reduced over chunks on up to `threads` threads
+inline SubarraySummary
+summarise_subarrays(std::vector<std::int32_t> const &values,
+                    std::uint32_t const threads = 1) {
+  std::vector<SubarraySummary> partial(std::max(1u, threads),
+                                       SubarraySummary::of(0));
+  parallel::for_each_chunk(
+      values.size(), threads,
+      [&](std::uint32_t const chunk, std::size_t const begin,
+          std::size_t const end) {
+        partial[chunk] = details::summarise(values.data() + begin, end - begin);
+      });
+  auto result = partial[0];
+  for (std::size_t chunk = 1; chunk < partial.size(); ++chunk)
+    result = result.then(partial[chunk]);
+  return result;
+}
+
+// the largest sum of a subarray of the cyclic array values (empty allowed):
+// either a plain subarray or the total minus a minimum subarray, O(n)
+inline std::uint64_t
+max_subarray_sum_cyclic(std::vector<std::int32_t> const &values,
+                        std::uint32_t const threads = 1) {
+  return static_cast<std::uint64_t>(
+      summarise_subarrays(values, threads).cyclic_best());
+}
+
+// the best subarray sums within the last `window` values of a stream. A queue
+// of two stacks holding combined summaries answers in O(1) amortised per value
+class SlidingSubarray {
+public:
+  explicit SlidingSubarray(std::size_t const window) : window(window) {}
+
+  void push(std::int32_t const value) {
+    if (window == 0)
+      return;
+    if (front.size() + back.size() == window)
+      pop();
+    auto const single = SubarraySummary::of(value);
+    back.push_back(
+        {value, back.empty() ? single : back.back().combined.then(single)});
+  }
+
+  // the largest sum of a subarray of the window, empty allowed
+  std::int64_t best() const { return summary().max_best; }
+
+  // the same, treating the window as a cyclic array
+  std::int64_t best_cyclic() const { return summary().cyclic_best(); }
+
+  SubarraySummary summary() const {
+    auto const oldest =
+        front.empty() ? SubarraySummary::of(0) : front.back().combined;
+    return back.empty() ? oldest : oldest.then(back.back().combined);
+  }
+
+private:
+  // combined summarises the entry with everything newer on its stack (front)
+  // or everything older on its stack (back)
+  struct Entry {
+    std::int32_t value;
+    SubarraySummary combined;
+  };
+
+  void pop() {
+    if (front.empty()) {
+      for (; !back.empty(); back.pop_back()) {
+        auto const single = SubarraySummary::of(back.back().value);
+        front.push_back({back.back().value,
+                         front.empty() ? single
+                                       : single.then(front.back().combined)});
+      }
+    }
+    front.pop_back();
+  }
+
+  std::size_t window;
+  std::vector<Entry> front;
+  std::vector<Entry> back;
+};
+
+} // namespace algorithms
+} // namespace dp
+} // namespace eopi
+
+#endif // EOPI_DP_SUBARRAY_HPP_
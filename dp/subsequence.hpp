@@ -0,0 +1,199 @@
+#ifndef EOPI_DP_SUBSEQUENCE_HPP_
+#define EOPI_DP_SUBSEQUENCE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace eopi {
+namespace dp {
+namespace algorithms {
+
+namespace details {
+enum : std::size_t { NO_PARENT = std::numeric_limits<std::size_t>::max() };
+
+// the number of tails not greater than value. The halving step compiles to a
+// conditional move, so the search never mispredicts
+inline std::size_t upper_bound_index(std::int32_t const *tails,
+                                     std::size_t const size,
+                                     std::int32_t const value) {
+  if (size == 0)
+    return 0;
+  auto base = tails;
+  for (auto n = size; n > 1;) {
+    auto const half = n / 2;
+    base = base[half - 1] <= value ? base + half : base;
+    n -= half;
+  }
+  return static_cast<std::size_t>(base - tails) + (*base <= value ? 1 : 0);
+}
+
+// the position in tails that value replaces, sorted input appends without
+// searching
+inline std::size_t patience_slot(std::vector<std::int32_t> const &tails,
+                                 std::int32_t const value) {
+  if (tails.empty() || tails.back() <= value)
+    return tails.size();
+  return upper_bound_index(tails.data(), tails.size(), value);
+}
+
+// patience sorting over the keys of data in processing order. Forward keys
+// are the values, backward keys walk from the end with every value
+// complemented, so tails holds the largest first values of nondecreasing
+// subsequences of the suffix (as ~value, sorted)
+struct Patience {
+  std::vector<std::int32_t> tails;
+  // processing order index of every tail and the predecessor of every
+  // element, only when tracked
+  std::vector<std::size_t> positions;
+  std::vector<std::size_t> parents;
+};
+
+inline Patience patience(std::int32_t const *data, std::size_t const size,
+                         bool const backward, bool const track) {
+  Patience result;
+  if (track)
+    result.parents.resize(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    auto const key = backward ? ~data[size - 1 - i] : data[i];
+    auto const slot = patience_slot(result.tails, key);
+    if (slot == result.tails.size()) {
+      result.tails.push_back(key);
+      if (track)
+        result.positions.push_back(i);
+    } else {
+      result.tails[slot] = key;
+      if (track)
+        result.positions[slot] = i;
+    }
+    if (track)
+      result.parents[i] = slot ? result.positions[slot - 1] : NO_PARENT;
+  }
+  return result;
+}
+
+// runs the forward patience over the first half of data and the backward one
+// over the second half concurrently. A nondecreasing subsequence ending at
+// most at v in the first half extends by any starting at least at v in the
+// second half, the best v is one of the first half's tails (or none)
+struct MeetInTheMiddle {
+  Patience front;
+  Patience back;
+  // the length taken from each half
+  std::size_t front_length;
+  std::size_t back_length;
+};
+
+inline MeetInTheMiddle split_patience(std::vector<std::int32_t> const &data,
+                                      bool const track) {
+  MeetInTheMiddle result;
+  auto const mid = data.size() / 2;
+  std::thread worker([&]() {
+    result.back =
+        patience(data.data() + mid, data.size() - mid, true, track);
+  });
+  result.front = patience(data.data(), mid, false, track);
+  worker.join();
+
+  auto const &tails = result.front.tails, &heads = result.back.tails;
+  result.front_length = 0;
+  result.back_length = heads.size();
+  for (std::size_t i = 0; i < tails.size(); ++i) {
+    // heads of at least tails[i] are the complements of at most ~tails[i]
+    auto const back =
+        upper_bound_index(heads.data(), heads.size(), ~tails[i]);
+    if (i + 1 + back > result.front_length + result.back_length) {
+      result.front_length = i + 1;
+      result.back_length = back;
+    }
+  }
+  return result;
+}
+
+// the values along the parents from the tail of the given length
+inline void follow_parents(std::int32_t const *data, std::size_t const size,
+                           Patience const &patience, std::size_t const length,
+                           bool const backward,
+                           std::vector<std::int32_t> &result) {
+  if (length == 0)
+    return;
+  for (auto cur = patience.positions[length - 1]; cur != NO_PARENT;
+       cur = patience.parents[cur])
+    result.push_back(backward ? data[size - 1 - cur] : data[cur]);
+}
+} // namespace details
+
+// the length of the longest nondecreasing subsequence of a stream of values,
+// in O(L) memory for a subsequence of length L
+class NondecreasingLength {
+public:
+  void push(std::int32_t const value) {
+    auto const slot = details::patience_slot(tails, value);
+    if (slot == tails.size())
+      tails.push_back(value);
+    else
+      tails[slot] = value;
+  }
+
+  std::size_t size() const { return tails.size(); }
+
+private:
+  // smallest last value of a subsequence of every length
+  std::vector<std::int32_t> tails;
+};
+
+// the length of the longest nondecreasing subsequence. With more than one
+// thread, both halves of a large input are processed concurrently
+inline std::size_t
+longest_nondecreasing_length(std::vector<std::int32_t> const &data,
+                             std::uint32_t const threads = 1) {
+  if (threads > 1 && data.size() >= (std::size_t{1} << 16)) {
+    auto const split = details::split_patience(data, false);
+    return split.front_length + split.back_length;
+  }
+  NondecreasingLength length;
+  for (auto value : data)
+    length.push(value);
+  return length.size();
+}
+
+// find a non-decreasing subsequence (A_i <= A_j for i < j) within data
+inline std::vector<std::int32_t>
+longest_nondecreasing_subsequence(std::vector<std::int32_t> const &data,
+                                  std::uint32_t const threads = 1) {
+  std::vector<std::int32_t> result;
+  if (threads > 1 && data.size() >= (std::size_t{1} << 16)) {
+    auto const split = details::split_patience(data, true);
+    auto const mid = data.size() / 2;
+    // the back half's parents already lead towards the end
+    std::vector<std::int32_t> back;
+    std::thread worker([&]() {
+      details::follow_parents(data.data() + mid, data.size() - mid,
+                              split.back, split.back_length, true, back);
+    });
+    details::follow_parents(data.data(), mid, split.front, split.front_length,
+                            false, result);
+    worker.join();
+    std::reverse(result.begin(), result.end());
+    result.insert(result.end(), back.begin(), back.end());
+    return result;
+  }
+
+  // for every possible length the smallest possible tail, with the parent of
+  // every entry that became a tail
+  auto const sequence =
+      details::patience(data.data(), data.size(), false, true);
+  details::follow_parents(data.data(), data.size(), sequence,
+                          sequence.tails.size(), false, result);
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+} // namespace algorithms
+} // namespace dp
+} // namespace eopi
+
+#endif // EOPI_DP_SUBSEQUENCE_HPP_
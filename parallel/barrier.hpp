@@ -0,0 +1,44 @@
+#ifndef EOPI_PARALLEL_BARRIER_HPP_
+#define EOPI_PARALLEL_BARRIER_HPP_
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace eopi {
+namespace parallel {
+
+// blocks until `count` threads have called wait, then releases all of them.
+// Reusable, so the same threads can synchronise once per round
+class Barrier {
+public:
+  explicit Barrier(std::uint32_t const count)
+      : count(count), waiting(0), generation(0) {}
+
+  Barrier(Barrier const &) = delete;
+  Barrier &operator=(Barrier const &) = delete;
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto const round = generation;
+    if (++waiting == count) {
+      waiting = 0;
+      ++generation;
+      condition.notify_all();
+      return;
+    }
+    condition.wait(lock, [&]() { return generation != round; });
+  }
+
+private:
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::uint32_t count;
+  std::uint32_t waiting;
+  std::uint64_t generation;
+};
+
+} // namespace parallel
+} // namespace eopi
+
+#endif // EOPI_PARALLEL_BARRIER_HPP_
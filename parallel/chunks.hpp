@@ -0,0 +1,53 @@
+#ifndef EOPI_PARALLEL_CHUNKS_HPP_
+#define EOPI_PARALLEL_CHUNKS_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace eopi {
+namespace parallel {
+
+// number of workers to use, when the caller does not specify any
+inline std::uint32_t default_threads() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// the range [begin,end) of the chunk-th out of `chunks` nearly equal sized
+// chunks of [0,size)
+inline std::pair<std::size_t, std::size_t>
+chunk_range(std::size_t const size, std::uint32_t const chunks,
+            std::uint32_t const chunk) {
+  auto const base = size / chunks, extra = size % chunks;
+  auto const begin = chunk * base + std::min<std::size_t>(chunk, extra);
+  return {begin, begin + base + (chunk < extra ? 1 : 0)};
+}
+
+// run func(chunk, begin, end) for every chunk of [0,size), each on its own
+// thread. The calling thread processes the first chunk itself.
+template <typename functor>
+void for_each_chunk(std::size_t const size, std::uint32_t chunks,
+                    functor func) {
+  chunks = static_cast<std::uint32_t>(
+      std::max<std::size_t>(1, std::min<std::size_t>(chunks, size)));
+
+  std::vector<std::thread> workers;
+  workers.reserve(chunks - 1);
+  for (std::uint32_t chunk = 1; chunk < chunks; ++chunk) {
+    auto const range = chunk_range(size, chunks, chunk);
+    workers.emplace_back(func, chunk, range.first, range.second);
+  }
+  auto const first = chunk_range(size, chunks, 0);
+  func(0u, first.first, first.second);
+
+  for (auto &worker : workers)
+    worker.join();
+}
+
+} // namespace parallel
+} // namespace eopi
+
+#endif // EOPI_PARALLEL_CHUNKS_HPP_
@@ -3,75 +3,168 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string>
 
 namespace eopi {
 namespace primitives {
 
-// convert a string given in base `a` into a string of base `b`. This only
-// works, as long as the encoded integer in input fits a 64bit unsigned
-inline std::string convert_base(std::string input, const std::uint32_t base,
-                                const std::uint32_t out_base) {
-  // we only handle bases between 2 and 16
-  auto const invalid_base = [](auto base) { return base <= 1 || base > 16; };
+namespace details {
+// value of every digit character, 0xFF for non digits
+struct DigitLookupTable {
+  constexpr DigitLookupTable() : value() {
+    for (std::uint32_t c = 0; c < 256; ++c)
+      value[c] = 0xFF;
+    for (std::uint32_t c = 0; c < 10; ++c)
+      value['0' + c] = static_cast<std::uint8_t>(c);
+    for (std::uint32_t c = 0; c < 26; ++c) {
+      value['a' + c] = static_cast<std::uint8_t>(10 + c);
+      value['A' + c] = static_cast<std::uint8_t>(10 + c);
+    }
+  }
 
-  if (input.empty() || invalid_base(base) || invalid_base(out_base))
+  std::uint8_t value[256];
+};
+
+// call func(field_begin, field_end) for every field of [begin,end) terminated
+// or separated by delimiter, an empty field after the last delimiter is
+// skipped
+template <typename functor>
+void for_each_field(char const *begin, char const *const end,
+                    char const delimiter, functor func) {
+  while (begin != end) {
+    auto field_end = static_cast<char const *>(std::memchr(
+        begin, delimiter, static_cast<std::size_t>(end - begin)));
+    if (!field_end)
+      field_end = end;
+    func(begin, field_end);
+    begin = field_end == end ? end : field_end + 1;
+  }
+}
+
+// we only handle bases between 2 and 16
+inline void check_conversion(bool const empty, std::uint32_t const base,
+                             std::uint32_t const out_base) {
+  auto const invalid_base = [](auto base) { return base <= 1 || base > 16; };
+  if (empty || invalid_base(base) || invalid_base(out_base))
     throw("Invalid input");
+}
+} // namespace details
+
+// convert the number in [begin,end) given in base `base` (2 to 16) into base
+// `out_base`, written to out which needs room for 65 bytes. Returns the end of
+// the output. This only works, as long as the number fits a 64bit unsigned
+inline char *convert_base(char const *begin, char const *const end,
+                          std::uint32_t const base,
+                          std::uint32_t const out_base, char *out) {
+  static const details::DigitLookupTable digits;
+  details::check_conversion(begin == end, base, out_base);
+
+  bool const negative = *begin == '-';
+  begin += negative ? 1 : 0;
+
+  std::uint64_t value = 0;
+  for (; begin != end; ++begin) {
+    auto const digit = digits.value[static_cast<std::uint8_t>(*begin)];
+    if (digit >= base)
+      throw("Invalid digit in string");
+    value = value * base + digit;
+  }
+
+  // digits are produced least significant first, from the back of a buffer
+  char buffer[64];
+  auto digit = buffer + sizeof(buffer);
+  do {
+    *--digit = "0123456789ABCDEF"[value % out_base];
+    value /= out_base;
+  } while (value);
 
+  if (negative)
+    *out++ = '-';
+  return std::copy(digit, buffer + sizeof(buffer), out);
+}
+
+// convert a string given in base `a` into a string of base `b`. This only
+// works, as long as the encoded integer in input fits a 64bit unsigned
+inline std::string convert_base(std::string const &input,
+                                const std::uint32_t base,
+                                const std::uint32_t out_base) {
+  details::check_conversion(input.empty(), base, out_base);
   // nothing to do?
   if (base == out_base)
     return input;
 
-  bool negative = input.front() == '-';
-  std::string result = "";
-
-  std::uint64_t remainder = 0;
+  char buffer[65];
+  return std::string(buffer, convert_base(input.data(),
+                                          input.data() + input.size(), base,
+                                          out_base, buffer));
+}
 
-  auto const to_digit = [](char c) {
-    if (!std::isxdigit(c))
-      throw("Invalid digit in string");
+// batch conversion of delimited fields, every converted field is terminated by
+// delimiter in the output, which needs room for 66 bytes per field
+inline char *convert_base(char const *begin, char const *end,
+                          char const delimiter, std::uint32_t const base,
+                          std::uint32_t const out_base, char *out) {
+  details::for_each_field(
+      begin, end, delimiter, [&](char const *field, char const *field_end) {
+        out = convert_base(field, field_end, base, out_base, out);
+        *out++ = delimiter;
+      });
+  return out;
+}
 
-    if (std::isdigit(c))
-      return c - '0';
-    else
-      return std::tolower(c) - 'a';
-  };
-
-  // only loop over digits of the input
-  std::uint64_t power = 1;
-  for (auto itr = input.begin() + (negative ? 1 : 0); itr != input.end();
-       ++itr) {
-    remainder += power * to_digit(*itr);
-    power *= base;
-  }
+// convert a spreadsheet encoding to the corresponding integer
+inline std::uint64_t spreadsheet_encoding(char const *begin,
+                                          char const *const end) {
+  std::uint64_t encoding = 0;
+  for (; begin != end; ++begin)
+    encoding = 26 * encoding + static_cast<std::uint64_t>(*begin - 'A' + 1);
+  return encoding;
+}
 
-  auto const as_digit = [](std::int32_t value) {
-    return value < 10 ? '0' + value : 'A' + (value - 10);
-  };
+inline std::uint64_t spreadsheet_encoding(std::string const &spread) {
+  return spreadsheet_encoding(spread.data(), spread.data() + spread.size());
+}
 
-  while (remainder) {
-    result.push_back(as_digit(remainder % out_base));
-    remainder /= out_base;
-  }
+// batch decoding of delimited columns into out, returns the number of columns
+inline std::size_t spreadsheet_encoding(char const *begin,
+                                        char const *const end,
+                                        char const delimiter,
+                                        std::uint64_t *const out) {
+  std::size_t count = 0;
+  details::for_each_field(
+      begin, end, delimiter, [&](char const *field, char const *field_end) {
+        out[count++] = spreadsheet_encoding(field, field_end);
+      });
+  return count;
+}
 
-  // add sign, when nevessary
-  if (negative)
-    result.push_back('-');
+// the spreadsheet column (1 is A, 27 is AA) into out, which needs room for 14
+// bytes. Returns the end of the output
+inline char *to_spreadsheet(std::uint64_t column, char *out) {
+  char buffer[14];
+  auto letter = buffer + sizeof(buffer);
+  for (; column; column = (column - 1) / 26)
+    *--letter = static_cast<char>('A' + (column - 1) % 26);
+  return std::copy(letter, buffer + sizeof(buffer), out);
+}
 
-  // finally reverse the result and return
-  std::reverse(result.begin(), result.end());
-  return result;
+inline std::string to_spreadsheet(std::uint64_t const column) {
+  char buffer[14];
+  return std::string(buffer, to_spreadsheet(column, buffer));
 }
 
-// convert a spreadsheet encoding to the corresponding integer
-inline std::uint64_t spreadsheet_encoding(std::string const &spread) {
-  std::uint64_t encoding = 0;
-  for (auto c : spread) {
-    encoding *= 26;
-    encoding += c - 'A' + 1;
+// batch encoding of columns, every column is terminated by delimiter
+inline char *to_spreadsheet(std::uint64_t const *begin,
+                            std::uint64_t const *const end,
+                            char const delimiter, char *out) {
+  for (; begin != end; ++begin) {
+    out = to_spreadsheet(*begin, out);
+    *out++ = delimiter;
   }
-  return encoding;
+  return out;
 }
 
 // reverse the digits of a number
@@ -4,12 +4,20 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <limits>
 #include <numeric>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "../parallel/chunks.hpp"
+
 namespace eopi {
 namespace search {
 
@@ -183,32 +191,183 @@ inline bool find_2d(std::vector<std::vector<int>> const &field, int value) {
   return false;
 }
 
-// find the min/max with less than 2n-1 comparisons
-template <typename value_type>
-std::pair<std::size_t, std::size_t>
-min_max(std::vector<value_type> const &data) {
+// find the min/max with about 3n/2 comparisons. Reports the first occurrence
+// of both the minimum and the maximum
+template <typename value_type, typename comparator_type>
+std::pair<std::size_t, std::size_t> min_max(std::vector<value_type> const &data,
+                                            comparator_type less) {
   std::size_t min = 0, max = 0;
   for (std::size_t i = 0; i + 1 < data.size(); i += 2) {
-    std::size_t less = i, more = i + 1;
-    if (data[i + 1] < data[i]) {
-      less = i + 1;
-      more = i;
+    std::size_t smaller = i, larger = i + 1;
+    if (less(data[i + 1], data[i])) {
+      smaller = i + 1;
+      larger = i;
     }
 
-    if (data[less] < data[min])
-      min = less;
-    if (data[max] < data[more])
-      max = more;
+    if (less(data[smaller], data[min]))
+      min = smaller;
+    // on a tie within the pair, the earlier element is the first maximum
+    if (less(data[max], data[larger]))
+      max = (larger == i + 1 && !less(data[i], data[larger])) ? i : larger;
   }
   if (data.size() % 2 == 1) {
-    if (data.back() < data[min])
+    if (less(data.back(), data[min]))
       min = data.size() - 1;
-    if (data[max] < data.back())
+    if (less(data[max], data.back()))
       max = data.size() - 1;
   }
   return {min, max};
 }
 
+namespace details {
+// min and max value of a non-empty range. Independent accumulators break the
+// dependency chain, so the compiler can vectorise the loop for any arithmetic
+// type
+template <typename value_type>
+std::pair<value_type, value_type> min_max_values(value_type const *data,
+                                                 std::size_t const size) {
+  std::size_t const constexpr lanes = 8;
+  value_type mins[lanes], maxs[lanes];
+  std::fill(mins, mins + lanes, data[0]);
+  std::fill(maxs, maxs + lanes, data[0]);
+
+  std::size_t i = 0;
+  for (; i + lanes <= size; i += lanes) {
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+      mins[lane] = data[i + lane] < mins[lane] ? data[i + lane] : mins[lane];
+      maxs[lane] = maxs[lane] < data[i + lane] ? data[i + lane] : maxs[lane];
+    }
+  }
+
+  auto result = std::make_pair(*std::min_element(mins, mins + lanes),
+                               *std::max_element(maxs, maxs + lanes));
+  for (; i < size; ++i) {
+    result.first = std::min(result.first, data[i]);
+    result.second = std::max(result.second, data[i]);
+  }
+  return result;
+}
+
+#if defined(__AVX512F__)
+inline std::pair<std::int32_t, std::int32_t>
+min_max_values(std::int32_t const *data, std::size_t const size) {
+  if (size < 16)
+    return min_max_values<std::int32_t>(data, size);
+
+  __m512i mins = _mm512_loadu_si512(data), maxs = mins;
+  std::size_t i = 16;
+  for (; i + 16 <= size; i += 16) {
+    auto const block = _mm512_loadu_si512(data + i);
+    mins = _mm512_min_epi32(mins, block);
+    maxs = _mm512_max_epi32(maxs, block);
+  }
+
+  auto result = std::make_pair(_mm512_reduce_min_epi32(mins),
+                               _mm512_reduce_max_epi32(maxs));
+  for (; i < size; ++i) {
+    result.first = std::min(result.first, data[i]);
+    result.second = std::max(result.second, data[i]);
+  }
+  return result;
+}
+#elif defined(__AVX2__)
+inline std::pair<std::int32_t, std::int32_t>
+min_max_values(std::int32_t const *data, std::size_t const size) {
+  if (size < 8)
+    return min_max_values<std::int32_t>(data, size);
+
+  __m256i mins = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data)),
+          maxs = mins;
+  std::size_t i = 8;
+  for (; i + 8 <= size; i += 8) {
+    auto const block =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + i));
+    mins = _mm256_min_epi32(mins, block);
+    maxs = _mm256_max_epi32(maxs, block);
+  }
+
+  std::int32_t lane_mins[8], lane_maxs[8];
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(lane_mins), mins);
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(lane_maxs), maxs);
+  auto result = std::make_pair(*std::min_element(lane_mins, lane_mins + 8),
+                               *std::max_element(lane_maxs, lane_maxs + 8));
+  for (; i < size; ++i) {
+    result.first = std::min(result.first, data[i]);
+    result.second = std::max(result.second, data[i]);
+  }
+  return result;
+}
+#endif
+
+// first occurrences of the min/max values within [begin,end) of data
+template <typename value_type>
+std::pair<std::size_t, std::size_t>
+min_max_vectorised(value_type const *data, std::size_t const begin,
+                   std::size_t const end) {
+  if (begin == end)
+    return {begin, begin};
+
+  // find the values without any index bookkeeping, then locate them. The
+  // second pass stops at the first occurrence
+  auto const values = min_max_values(data + begin, end - begin);
+  return {static_cast<std::size_t>(
+              std::find(data + begin, data + end, values.first) - data),
+          static_cast<std::size_t>(
+              std::find(data + begin, data + end, values.second) - data)};
+}
+
+template <typename value_type>
+std::pair<std::size_t, std::size_t>
+min_max_dispatch(std::vector<value_type> const &data, std::true_type) {
+  return min_max_vectorised(data.data(), 0, data.size());
+}
+
+template <typename value_type>
+std::pair<std::size_t, std::size_t>
+min_max_dispatch(std::vector<value_type> const &data, std::false_type) {
+  return min_max(data, std::less<value_type>());
+}
+} // namespace details
+
+// find the first occurrence of the min/max. Arithmetic values (without NaNs)
+// use a vectorised reduction, all others the pairwise comparison scheme
+template <typename value_type>
+std::pair<std::size_t, std::size_t>
+min_max(std::vector<value_type> const &data) {
+  return details::min_max_dispatch(
+      data, typename std::is_arithmetic<value_type>::type());
+}
+
+// reduce chunks of the data in parallel, each of them vectorised
+template <typename value_type>
+std::pair<std::size_t, std::size_t>
+min_max_parallel(std::vector<value_type> const &data,
+                 std::uint32_t const threads = parallel::default_threads()) {
+  static_assert(std::is_arithmetic<value_type>::value,
+                "min_max_parallel requires arithmetic values");
+  if (data.empty())
+    return {0, 0};
+
+  std::vector<std::pair<std::size_t, std::size_t>> partial(
+      std::max(1u, threads), {0, 0});
+  parallel::for_each_chunk(data.size(), threads, [&](auto const chunk,
+                                                     auto const begin,
+                                                     auto const end) {
+    partial[chunk] = details::min_max_vectorised(data.data(), begin, end);
+  });
+
+  // chunks are ordered, so only a strictly better chunk replaces the result.
+  // Unused chunks point to the first element, which is never strictly better
+  auto result = partial.front();
+  for (std::size_t chunk = 1; chunk < partial.size(); ++chunk) {
+    if (data[partial[chunk].first] < data[result.first])
+      result.first = partial[chunk].first;
+    if (data[result.second] < data[partial[chunk].second])
+      result.second = partial[chunk].second;
+  }
+  return result;
+}
+
 template <typename randitr, typename value_type>
 randitr partition(randitr begin, randitr end, value_type const pivot) {
   randitr less = begin, equal = begin, larger = end;
@@ -2,17 +2,48 @@
 #define EOPI_SORTING_ALGORITHMS_HPP_
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "../parallel/chunks.hpp"
+
 namespace eopi {
 namespace sorting {
 namespace algorithms {
 
+namespace details {
+// map a key to an unsigned value of the same width with the same ordering
+template <typename key_type>
+typename std::make_unsigned<key_type>::type radix_key(key_type const key) {
+  using unsigned_type = typename std::make_unsigned<key_type>::type;
+  auto const constexpr sign =
+      std::is_signed<key_type>::value
+          ? static_cast<unsigned_type>(unsigned_type{1}
+                                       << (8 * sizeof(key_type) - 1))
+          : unsigned_type{0};
+  return static_cast<unsigned_type>(static_cast<unsigned_type>(key) ^ sign);
+}
+
+// the byte of a key at bit-offset shift, in radix order
+template <typename key_type>
+std::size_t radix_digit(key_type const key, std::uint32_t const shift) {
+  return static_cast<std::size_t>((radix_key(key) >> shift) & 0xFF);
+}
+
 template <typename container_type>
-void counting_sort(container_type &container) {
+void counting_sort_hashed(container_type &container) {
   using key_type = typename container_type::value_type::key_type;
   std::unordered_map<key_type, std::uint64_t> key_counts;
   std::vector<key_type> unique_keys;
@@ -45,25 +76,339 @@ void counting_sort(container_type &container) {
   }
 }
 
-// compute the set intersection of two lists
-inline std::vector<std::int32_t>
-set_intersect(std::vector<std::int32_t> const &lhs,
-              std::vector<std::int32_t> const &rhs) {
-  std::vector<std::int32_t> result;
-  std::size_t left = 0, right = 0;
+// in-place MSD radix sort of [begin,end) on the byte at shift and below
+template <typename container_type>
+void american_flag_sort(container_type &container, std::size_t const begin,
+                        std::size_t const end, std::uint32_t const shift) {
+  // small buckets are cheaper to sort by comparison
+  if (end - begin < 32) {
+    std::sort(container.begin() + begin, container.begin() + end,
+              [](auto const &lhs, auto const &rhs) {
+                return radix_key(lhs.key()) < radix_key(rhs.key());
+              });
+    return;
+  }
+
+  std::size_t counts[256] = {};
+  for (std::size_t i = begin; i < end; ++i)
+    ++counts[radix_digit(container[i].key(), shift)];
+
+  std::size_t heads[256], tails[256];
+  for (std::size_t digit = 0, offset = begin; digit < 256; ++digit) {
+    heads[digit] = offset;
+    offset += counts[digit];
+    tails[digit] = offset;
+  }
+
+  // cycle every element into its bucket, one swap per misplaced element
+  for (std::size_t digit = 0; digit < 256; ++digit) {
+    while (heads[digit] < tails[digit]) {
+      auto const target = radix_digit(container[heads[digit]].key(), shift);
+      if (target == digit)
+        ++heads[digit];
+      else
+        std::swap(container[heads[digit]], container[heads[target]++]);
+    }
+  }
+
+  if (shift == 0)
+    return;
+  for (std::size_t digit = 0, offset = begin; digit < 256; ++digit) {
+    if (counts[digit] > 1)
+      american_flag_sort(container, offset, offset + counts[digit], shift - 8);
+    offset += counts[digit];
+  }
+}
+
+template <typename container_type>
+void counting_sort_dispatch(container_type &container, std::true_type) {
+  using key_type = typename container_type::value_type::key_type;
+  american_flag_sort(container, 0, container.size(),
+                     8 * (sizeof(key_type) - 1));
+}
+
+template <typename container_type>
+void counting_sort_dispatch(container_type &container, std::false_type) {
+  counting_sort_hashed(container);
+}
+} // namespace details
+
+// sort elements by their key(). Integral keys are sorted in-place by an
+// American flag sort, all other keys by counting through a hash map
+template <typename container_type>
+void counting_sort(container_type &container) {
+  using key_type = typename container_type::value_type::key_type;
+  details::counting_sort_dispatch(container,
+                                  typename std::is_integral<key_type>::type());
+}
+
+// stable LSD radix sort by an integral key(), using a buffer of the same size.
+// Passes in which all keys share the same byte are skipped
+template <typename container_type>
+void radix_sort(container_type &container) {
+  using value_type = typename container_type::value_type;
+  using key_type = typename value_type::key_type;
+  static_assert(std::is_integral<key_type>::value,
+                "radix_sort requires integral keys");
+
+  std::vector<value_type> buffer(container.begin(), container.end());
+  bool in_buffer = false;
+  for (std::uint32_t shift = 0; shift < 8 * sizeof(key_type); shift += 8) {
+    auto const pass = [&](auto const &from, auto &to) {
+      std::size_t offsets[256] = {};
+      for (auto const &elem : from)
+        ++offsets[details::radix_digit(elem.key(), shift)];
+      if (std::find(offsets, offsets + 256, from.size()) != offsets + 256)
+        return false;
+
+      for (std::size_t digit = 0, offset = 0; digit < 256; ++digit) {
+        auto const count = offsets[digit];
+        offsets[digit] = offset;
+        offset += count;
+      }
+      for (auto const &elem : from)
+        to[offsets[details::radix_digit(elem.key(), shift)]++] = elem;
+      return true;
+    };
+
+    if (in_buffer ? pass(buffer, container) : pass(container, buffer))
+      in_buffer = !in_buffer;
+  }
+
+  if (in_buffer)
+    std::copy(buffer.begin(), buffer.end(), container.begin());
+}
+
+// stable LSD radix sort, distributing every pass over threads. Each thread
+// counts the digits of its own chunk, so the scatter of all chunks can run
+// concurrently into disjoint slots
+template <typename container_type>
+void radix_sort_parallel(
+    container_type &container,
+    std::uint32_t threads = parallel::default_threads()) {
+  using value_type = typename container_type::value_type;
+  using key_type = typename value_type::key_type;
+  static_assert(std::is_integral<key_type>::value,
+                "radix_sort_parallel requires integral keys");
+  if (container.empty())
+    return;
+  threads = static_cast<std::uint32_t>(
+      std::max<std::size_t>(1, std::min<std::size_t>(threads, container.size())));
+
+  std::vector<value_type> buffer(container.begin(), container.end());
+  std::vector<std::array<std::size_t, 256>> offsets(threads);
+  bool in_buffer = false;
+  for (std::uint32_t shift = 0; shift < 8 * sizeof(key_type); shift += 8) {
+    auto const pass = [&](auto const &from, auto &to) {
+      parallel::for_each_chunk(from.size(), threads, [&](auto const chunk,
+                                                         auto const begin,
+                                                         auto const end) {
+        offsets[chunk].fill(0);
+        for (auto i = begin; i < end; ++i)
+          ++offsets[chunk][details::radix_digit(from[i].key(), shift)];
+      });
+
+      // exclusive prefix sum, digit-major and thread-minor to stay stable
+      std::size_t offset = 0;
+      for (std::size_t digit = 0; digit < 256; ++digit) {
+        auto const digit_begin = offset;
+        for (std::uint32_t chunk = 0; chunk < threads; ++chunk) {
+          auto const count = offsets[chunk][digit];
+          offsets[chunk][digit] = offset;
+          offset += count;
+        }
+        if (offset - digit_begin == from.size())
+          return false;
+      }
+
+      parallel::for_each_chunk(from.size(), threads, [&](auto const chunk,
+                                                         auto const begin,
+                                                         auto const end) {
+        for (auto i = begin; i < end; ++i)
+          to[offsets[chunk][details::radix_digit(from[i].key(), shift)]++] =
+              from[i];
+      });
+      return true;
+    };
+
+    if (in_buffer ? pass(buffer, container) : pass(container, buffer))
+      in_buffer = !in_buffer;
+  }
+
+  if (in_buffer)
+    std::copy(buffer.begin(), buffer.end(), container.begin());
+}
+
+namespace details {
+inline void emit_unique(std::vector<std::int32_t> &result,
+                        std::int32_t const value) {
+  if (result.empty() || result.back() != value)
+    result.push_back(value);
+}
+
+// two pointer intersection, starting at lhs[left] / rhs[right]
+inline void merge_intersect(std::vector<std::int32_t> const &lhs,
+                            std::size_t left,
+                            std::vector<std::int32_t> const &rhs,
+                            std::size_t right,
+                            std::vector<std::int32_t> &result) {
   while (left < lhs.size() && right < rhs.size()) {
     if (lhs[left] < rhs[right]) {
       ++left;
     } else if (rhs[right] < lhs[left]) {
       ++right;
     } else {
-      if (result.empty() || result.back() != lhs[left])
-        result.push_back(lhs[left]);
-
+      emit_unique(result, lhs[left]);
       ++left;
       ++right;
     }
   }
+}
+
+// emit the lanes of values selected by mask, in lane order
+inline void emit_mask(std::vector<std::int32_t> &result,
+                      std::int32_t const *values, std::uint32_t mask) {
+  while (mask) {
+    emit_unique(result, values[__builtin_ctz(mask)]);
+    mask &= mask - 1;
+  }
+}
+
+#if defined(__AVX2__)
+std::size_t const constexpr intersect_block = 8;
+
+// mask of the lanes in lhs[0,8) equal to any of rhs[0,8)
+inline std::uint32_t block_matches(std::int32_t const *lhs,
+                                   std::int32_t const *rhs) {
+  auto const rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+  auto const lhs_block =
+      _mm256_loadu_si256(reinterpret_cast<__m256i const *>(lhs));
+  auto rhs_block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(rhs));
+  auto matches = _mm256_cmpeq_epi32(lhs_block, rhs_block);
+  for (std::size_t i = 1; i < intersect_block; ++i) {
+    rhs_block = _mm256_permutevar8x32_epi32(rhs_block, rotate);
+    matches =
+        _mm256_or_si256(matches, _mm256_cmpeq_epi32(lhs_block, rhs_block));
+  }
+  return _mm256_movemask_ps(_mm256_castsi256_ps(matches));
+}
+#elif defined(__SSE2__)
+std::size_t const constexpr intersect_block = 4;
+
+// mask of the lanes in lhs[0,4) equal to any of rhs[0,4)
+inline std::uint32_t block_matches(std::int32_t const *lhs,
+                                   std::int32_t const *rhs) {
+  auto const lhs_block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(lhs));
+  auto const rhs_block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(rhs));
+  auto const matches = _mm_or_si128(
+      _mm_or_si128(
+          _mm_cmpeq_epi32(lhs_block, rhs_block),
+          _mm_cmpeq_epi32(lhs_block, _mm_shuffle_epi32(rhs_block, 0x39))),
+      _mm_or_si128(
+          _mm_cmpeq_epi32(lhs_block, _mm_shuffle_epi32(rhs_block, 0x4E)),
+          _mm_cmpeq_epi32(lhs_block, _mm_shuffle_epi32(rhs_block, 0x93))));
+  return _mm_movemask_ps(_mm_castsi128_ps(matches));
+}
+#endif
+} // namespace details
+
+// compute the set intersection of two lists
+inline std::vector<std::int32_t>
+set_intersect(std::vector<std::int32_t> const &lhs,
+              std::vector<std::int32_t> const &rhs) {
+  std::vector<std::int32_t> result;
+  details::merge_intersect(lhs, 0, rhs, 0, result);
+  return result;
+}
+
+// intersection for lists of very different sizes: every element of the small
+// list is located by an exponential search in the large list, starting from
+// the previous match. O(m log(n/m)) for m = |small|
+inline std::vector<std::int32_t>
+set_intersect_galloping(std::vector<std::int32_t> const &lhs,
+                        std::vector<std::int32_t> const &rhs) {
+  auto const &small = lhs.size() <= rhs.size() ? lhs : rhs;
+  auto const &large = lhs.size() <= rhs.size() ? rhs : lhs;
+
+  std::vector<std::int32_t> result;
+  std::size_t pos = 0;
+  for (std::size_t i = 0; i < small.size() && pos < large.size(); ++i) {
+    auto const value = small[i];
+    if (i > 0 && small[i - 1] == value)
+      continue;
+
+    // double the step until we pass the value, then binary search the range
+    std::size_t step = 1;
+    while (pos + step < large.size() && large[pos + step] < value)
+      step *= 2;
+    pos = std::lower_bound(large.begin() + pos + step / 2,
+                           large.begin() + std::min(pos + step + 1,
+                                                    large.size()),
+                           value) -
+          large.begin();
+
+    if (pos < large.size() && large[pos] == value)
+      details::emit_unique(result, value);
+  }
+  return result;
+}
+
+// intersection of lists of similar size, comparing all pairs of a block of
+// each list at once (8x8 with AVX2, 4x4 with SSE2). The block with the
+// smaller maximum is replaced, all its partners have been seen by then
+inline std::vector<std::int32_t>
+set_intersect_block(std::vector<std::int32_t> const &lhs,
+                    std::vector<std::int32_t> const &rhs) {
+  std::vector<std::int32_t> result;
+  std::size_t left = 0, right = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+  auto const width = details::intersect_block;
+  while (left + width <= lhs.size() && right + width <= rhs.size()) {
+    details::emit_mask(result, &lhs[left],
+                       details::block_matches(&lhs[left], &rhs[right]));
+
+    auto const lhs_max = lhs[left + width - 1],
+               rhs_max = rhs[right + width - 1];
+    if (lhs_max <= rhs_max)
+      left += width;
+    if (rhs_max <= lhs_max)
+      right += width;
+  }
+#endif
+  details::merge_intersect(lhs, left, rhs, right, result);
+  return result;
+}
+
+// choose the intersection kernel from the size ratio of the lists
+inline std::vector<std::int32_t>
+set_intersect_adaptive(std::vector<std::int32_t> const &lhs,
+                       std::vector<std::int32_t> const &rhs) {
+  std::size_t const constexpr skew = 32;
+  auto const small = std::min(lhs.size(), rhs.size()),
+             large = std::max(lhs.size(), rhs.size());
+  if (small * skew < large)
+    return set_intersect_galloping(lhs, rhs);
+  return set_intersect_block(lhs, rhs);
+}
+
+// intersect K lists, smallest first, so that the running result only shrinks
+// and the skew towards the remaining lists grows
+inline std::vector<std::int32_t>
+set_intersect(std::vector<std::vector<std::int32_t>> const &lists) {
+  if (lists.empty())
+    return {};
+
+  std::vector<std::vector<std::int32_t> const *> by_size;
+  for (auto const &list : lists)
+    by_size.push_back(&list);
+  std::sort(by_size.begin(), by_size.end(),
+            [](auto lhs, auto rhs) { return lhs->size() < rhs->size(); });
+
+  auto result = by_size.size() == 1
+                    ? set_intersect(*by_size[0], *by_size[0])
+                    : set_intersect_adaptive(*by_size[0], *by_size[1]);
+  for (std::size_t i = 2; i < by_size.size() && !result.empty(); ++i)
+    result = set_intersect_adaptive(result, *by_size[i]);
   return result;
 }
 
@@ -89,6 +434,132 @@ inline void semi_inplace_merge(std::vector<std::int32_t> &lhs,
   // left-end to 0 is already in the correct place
 }
 
+namespace details {
+// number of elements taken from lhs within the first `diagonal` elements of
+// the stable merge of lhs and rhs (merge path). Ties are taken from lhs first
+template <typename iterator_type>
+std::size_t merge_path(iterator_type const lhs, std::size_t const lhs_size,
+                       iterator_type const rhs, std::size_t const rhs_size,
+                       std::size_t const diagonal) {
+  std::size_t begin = diagonal > rhs_size ? diagonal - rhs_size : 0,
+              end = std::min(diagonal, lhs_size);
+  while (begin < end) {
+    auto const middle = begin + (end - begin) / 2;
+    if (!(rhs[diagonal - middle - 1] < lhs[middle]))
+      begin = middle + 1;
+    else
+      end = middle;
+  }
+  return begin;
+}
+
+// stable merge of two sorted ranges into out. The output is cut into equal
+// chunks, the merge path of every cut gives independent sub-merges
+template <typename iterator_type, typename output_iterator>
+void merge_parallel(iterator_type const lhs, std::size_t const lhs_size,
+                    iterator_type const rhs, std::size_t const rhs_size,
+                    output_iterator const out, std::uint32_t const threads) {
+  parallel::for_each_chunk(
+      lhs_size + rhs_size, threads,
+      [&](auto, auto const begin, auto const end) {
+        auto const lhs_begin = merge_path(lhs, lhs_size, rhs, rhs_size, begin),
+                   lhs_end = merge_path(lhs, lhs_size, rhs, rhs_size, end);
+        std::merge(lhs + lhs_begin, lhs + lhs_end, rhs + (begin - lhs_begin),
+                   rhs + (end - lhs_end), out + begin);
+      });
+}
+
+// merge [first,middle) and [middle,last) without a second array: split the
+// larger half at its middle, find the cut in the other half, rotate the inner
+// parts into place and merge both sides concurrently
+template <typename iterator_type>
+void inplace_merge_parallel(iterator_type const first,
+                            iterator_type const middle,
+                            iterator_type const last,
+                            std::uint32_t const threads) {
+  if (first == middle || middle == last)
+    return;
+  if (threads <= 1 || last - first < 4096) {
+    std::inplace_merge(first, middle, last);
+    return;
+  }
+
+  iterator_type cut_lhs, cut_rhs;
+  if (middle - first >= last - middle) {
+    cut_lhs = first + (middle - first) / 2;
+    cut_rhs = std::lower_bound(middle, last, *cut_lhs);
+  } else {
+    cut_rhs = middle + (last - middle) / 2;
+    cut_lhs = std::upper_bound(first, middle, *cut_rhs);
+  }
+  auto const new_middle = std::rotate(cut_lhs, middle, cut_rhs);
+
+  std::thread worker(inplace_merge_parallel<iterator_type>, first, cut_lhs,
+                     new_middle, threads / 2);
+  inplace_merge_parallel(new_middle, cut_rhs, last, threads - threads / 2);
+  worker.join();
+}
+} // namespace details
+
+// stable merge sort: every thread sorts a run of its own, then the runs are
+// merged pairwise, each merge split across all threads along its merge path
+template <typename value_type>
+void merge_sort_parallel(std::vector<value_type> &data,
+                         std::uint32_t threads = parallel::default_threads()) {
+  if (data.size() < 2)
+    return;
+  threads = static_cast<std::uint32_t>(
+      std::max<std::size_t>(1, std::min<std::size_t>(threads, data.size())));
+
+  std::vector<std::size_t> bounds;
+  for (std::uint32_t chunk = 0; chunk < threads; ++chunk)
+    bounds.push_back(parallel::chunk_range(data.size(), threads, chunk).first);
+  bounds.push_back(data.size());
+
+  parallel::for_each_chunk(data.size(), threads, [&](auto, auto const begin,
+                                                     auto const end) {
+    std::stable_sort(data.begin() + begin, data.begin() + end);
+  });
+
+  std::vector<value_type> buffer(data);
+  auto *from = &data, *to = &buffer;
+  while (bounds.size() > 2) {
+    std::vector<std::size_t> merged_bounds;
+    std::size_t run = 0;
+    for (; run + 2 < bounds.size(); run += 2) {
+      details::merge_parallel(
+          from->begin() + bounds[run], bounds[run + 1] - bounds[run],
+          from->begin() + bounds[run + 1], bounds[run + 2] - bounds[run + 1],
+          to->begin() + bounds[run], threads);
+      merged_bounds.push_back(bounds[run]);
+    }
+    // an odd run out is carried over to the next round
+    if (run + 1 < bounds.size()) {
+      std::copy(from->begin() + bounds[run], from->end(),
+                to->begin() + bounds[run]);
+      merged_bounds.push_back(bounds[run]);
+    }
+    merged_bounds.push_back(data.size());
+    bounds.swap(merged_bounds);
+    std::swap(from, to);
+  }
+
+  if (from != &data)
+    data.swap(buffer);
+}
+
+// the contract of semi_inplace_merge, merging in place across threads
+inline void
+semi_inplace_merge_parallel(std::vector<std::int32_t> &lhs,
+                            std::vector<std::int32_t> const &rhs,
+                            std::uint32_t const threads =
+                                parallel::default_threads()) {
+  auto const middle = lhs.size();
+  lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+  details::inplace_merge_parallel(lhs.begin(), lhs.begin() + middle, lhs.end(),
+                                  threads);
+}
+
 // for a set of durations, find pairs of min-max sum
 inline std::vector<std::pair<std::uint32_t, std::uint32_t>>
 schedule(std::vector<std::uint32_t> &durations) {
@@ -0,0 +1,338 @@
+#ifndef EOPI_STRINGS_AHO_CORASICK_HPP_
+#define EOPI_STRINGS_AHO_CORASICK_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace eopi {
+namespace strings {
+
+// multi-pattern search over a stream of chunks. The automaton is a complete
+// DFA stored as a single contiguous table, with columns only for the bytes
+// that occur in any pattern (all other bytes share one column). While in the
+// root state, the text is skipped ahead to the next byte that can start a
+// pattern, using vector compares for small sets of start bytes and a nibble
+// table classifier for larger ones.
+class AhoCorasick {
+public:
+  enum : std::uint32_t { NONE = std::numeric_limits<std::uint32_t>::max() };
+
+  explicit AhoCorasick(std::vector<std::string> const &patterns)
+      : byte_class(), is_first(), first_low(), first_high(), state(0),
+        offset(0) {
+    for (auto const &pattern : patterns)
+      lengths.push_back(pattern.size());
+
+    // compress the alphabet, column 0 collects all bytes not in any pattern
+    classes = 1;
+    for (auto const &pattern : patterns) {
+      for (auto c : pattern) {
+        auto &byte = byte_class[static_cast<std::uint8_t>(c)];
+        if (byte == 0)
+          byte = classes++;
+      }
+      if (pattern.empty())
+        continue;
+      auto const first = static_cast<std::uint8_t>(pattern[0]);
+      if (!is_first[first]) {
+        is_first[first] = true;
+        first_bytes.push_back(first);
+      }
+    }
+    // the start byte c sets bit (c >> 4) % 8 of the row of its low nibble,
+    // in first_low for high nibbles below 8 and in first_high otherwise
+    for (auto c : first_bytes)
+      (c < 0x80 ? first_low : first_high)[c & 0x0F] |=
+          static_cast<std::uint8_t>(1u << ((c >> 4) & 7));
+
+    // trie of all patterns, missing transitions are NONE
+    transitions.assign(classes, NONE);
+    std::vector<std::uint32_t> terminal_of(patterns.size(), NONE);
+    for (std::uint32_t id = 0; id < patterns.size(); ++id) {
+      if (patterns[id].empty())
+        continue;
+      std::uint32_t node = 0;
+      for (auto c : patterns[id]) {
+        auto const slot =
+            node * classes + byte_class[static_cast<std::uint8_t>(c)];
+        if (transitions[slot] == NONE) {
+          transitions[slot] =
+              static_cast<std::uint32_t>(transitions.size() / classes);
+          transitions.resize(transitions.size() + classes, NONE);
+        }
+        node = transitions[slot];
+      }
+      terminal_of[id] = node;
+    }
+    auto const states = transitions.size() / classes;
+
+    // pattern ids ending in every state, grouped by state
+    pattern_begin.assign(states + 1, 0);
+    for (auto node : terminal_of)
+      if (node != NONE)
+        ++pattern_begin[node + 1];
+    for (std::size_t node = 0; node < states; ++node)
+      pattern_begin[node + 1] += pattern_begin[node];
+    pattern_ids.resize(pattern_begin.back());
+    auto fill = pattern_begin;
+    for (std::uint32_t id = 0; id < patterns.size(); ++id)
+      if (terminal_of[id] != NONE)
+        pattern_ids[fill[terminal_of[id]]++] = id;
+
+    // breadth first search computing the failure links, completing the DFA
+    // and linking every state to the closest reporting state on its failure
+    // chain
+    std::vector<std::uint32_t> failure(states, 0);
+    output.assign(states, NONE);
+    output_link.assign(states, NONE);
+    std::queue<std::uint32_t> queue;
+    for (std::uint32_t c = 0; c < classes; ++c) {
+      auto &next = transitions[c];
+      if (next == NONE)
+        next = 0;
+      else
+        queue.push(next);
+    }
+    while (!queue.empty()) {
+      auto const node = queue.front();
+      queue.pop();
+      auto const fail = failure[node];
+      output_link[node] = output[fail];
+      output[node] = reports(node) ? node : output_link[node];
+      for (std::uint32_t c = 0; c < classes; ++c) {
+        auto &next = transitions[node * classes + c];
+        if (next == NONE) {
+          next = transitions[fail * classes + c];
+        } else {
+          failure[next] = transitions[fail * classes + c];
+          queue.push(next);
+        }
+      }
+    }
+  }
+
+  // feed the next chunk of the stream. Reports on_match(pattern, position) for
+  // every occurrence ending in this chunk, where position is the offset of the
+  // first byte of the match within the whole stream
+  template <typename functor>
+  void scan(char const *begin, char const *const end, functor on_match) {
+    auto const chunk_offset = offset;
+    auto itr = begin;
+    while (itr != end) {
+      if (state == 0) {
+        itr = skip_to_candidate(itr, end);
+        if (itr == end)
+          break;
+      }
+      state = transitions[state * classes +
+                          byte_class[static_cast<std::uint8_t>(*itr)]];
+      ++itr;
+
+      for (auto node = output[state]; node != NONE; node = output_link[node]) {
+        auto const stream_end = chunk_offset + (itr - begin);
+        for (auto i = pattern_begin[node]; i < pattern_begin[node + 1]; ++i)
+          on_match(pattern_ids[i], stream_end - lengths[pattern_ids[i]]);
+      }
+    }
+    offset += end - begin;
+  }
+
+  template <typename functor>
+  void scan(std::string const &chunk, functor on_match) {
+    scan(chunk.data(), chunk.data() + chunk.size(), on_match);
+  }
+
+  // start a new stream
+  void reset() {
+    state = 0;
+    offset = 0;
+  }
+
+  // all (pattern, position) pairs within a single text
+  std::vector<std::pair<std::uint32_t, std::uint64_t>>
+  find_all(std::string const &text) {
+    reset();
+    std::vector<std::pair<std::uint32_t, std::uint64_t>> matches;
+    scan(text, [&](auto const pattern, auto const position) {
+      matches.emplace_back(pattern, position);
+    });
+    reset();
+    return matches;
+  }
+
+private:
+  bool reports(std::uint32_t const node) const {
+    return pattern_begin[node] != pattern_begin[node + 1];
+  }
+
+  // the first byte in [begin,end) that can start a pattern
+  char const *skip_to_candidate(char const *begin, char const *end) const {
+#if defined(__AVX2__) || defined(__SSSE3__)
+    if (first_bytes.size() > 4)
+      begin = skip_by_class(begin, end);
+#endif
+#if defined(__AVX2__) || defined(__SSE2__)
+    if (first_bytes.size() <= 4) {
+#if defined(__AVX2__)
+      using vector_type = __m256i;
+      std::size_t const constexpr width = 32;
+      auto const splat = [](std::uint8_t c) {
+        return _mm256_set1_epi8(static_cast<char>(c));
+      };
+      auto const matches = [](vector_type block, vector_type c) {
+        return _mm256_cmpeq_epi8(block, c);
+      };
+      auto const combine = [](vector_type lhs, vector_type rhs) {
+        return _mm256_or_si256(lhs, rhs);
+      };
+      auto const load = [](char const *from) {
+        return _mm256_loadu_si256(reinterpret_cast<vector_type const *>(from));
+      };
+      auto const mask = [](vector_type v) {
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(v));
+      };
+#else
+      using vector_type = __m128i;
+      std::size_t const constexpr width = 16;
+      auto const splat = [](std::uint8_t c) {
+        return _mm_set1_epi8(static_cast<char>(c));
+      };
+      auto const matches = [](vector_type block, vector_type c) {
+        return _mm_cmpeq_epi8(block, c);
+      };
+      auto const combine = [](vector_type lhs, vector_type rhs) {
+        return _mm_or_si128(lhs, rhs);
+      };
+      auto const load = [](char const *from) {
+        return _mm_loadu_si128(reinterpret_cast<vector_type const *>(from));
+      };
+      auto const mask = [](vector_type v) {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(v));
+      };
+#endif
+      // unused slots repeat the first start byte
+      vector_type starts[4];
+      for (std::size_t i = 0; i < 4; ++i)
+        starts[i] = splat(first_bytes.empty()
+                              ? 0
+                              : first_bytes[i < first_bytes.size() ? i : 0]);
+      for (; !first_bytes.empty() && begin + width <= end; begin += width) {
+        auto const block = load(begin);
+        auto const hits =
+            mask(combine(combine(matches(block, starts[0]),
+                                 matches(block, starts[1])),
+                         combine(matches(block, starts[2]),
+                                 matches(block, starts[3]))));
+        if (hits)
+          return begin + __builtin_ctz(hits);
+      }
+    }
+#endif
+    while (begin != end && !is_first[static_cast<std::uint8_t>(*begin)])
+      ++begin;
+    return begin;
+  }
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+  // skips whole blocks without a start byte, any number of them. Shuffles
+  // look up the row of every low nibble and the bit of every high nibble, a
+  // byte can start a pattern iff the two overlap
+  char const *skip_by_class(char const *begin, char const *end) const {
+#if defined(__AVX2__)
+    auto const table = [](std::uint8_t const *row) {
+      return _mm256_broadcastsi128_si256(
+          _mm_loadu_si128(reinterpret_cast<__m128i const *>(row)));
+    };
+    auto const low = table(first_low), high = table(first_high);
+    auto const bits = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8,
+        16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    auto const nibble = _mm256_set1_epi8(0x0F), seven = _mm256_set1_epi8(7);
+    auto const zero = _mm256_setzero_si256();
+    for (; begin + 32 <= end; begin += 32) {
+      auto const block =
+          _mm256_loadu_si256(reinterpret_cast<__m256i const *>(begin));
+      auto const lo = _mm256_and_si256(block, nibble);
+      auto const hi = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble);
+      auto const upper = _mm256_cmpgt_epi8(hi, seven);
+      auto const rows =
+          _mm256_blendv_epi8(_mm256_shuffle_epi8(low, lo),
+                             _mm256_shuffle_epi8(high, lo), upper);
+      auto const hits = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(
+          _mm256_cmpeq_epi8(
+              _mm256_and_si256(rows, _mm256_shuffle_epi8(bits, hi)), zero)));
+      if (hits)
+        return begin + __builtin_ctz(hits);
+    }
+#else
+    auto const low =
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(first_low));
+    auto const high =
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(first_high));
+    auto const bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8,
+                                    16, 32, 64, -128);
+    auto const nibble = _mm_set1_epi8(0x0F), seven = _mm_set1_epi8(7);
+    auto const zero = _mm_setzero_si128();
+    for (; begin + 16 <= end; begin += 16) {
+      auto const block =
+          _mm_loadu_si128(reinterpret_cast<__m128i const *>(begin));
+      auto const lo = _mm_and_si128(block, nibble);
+      auto const hi = _mm_and_si128(_mm_srli_epi16(block, 4), nibble);
+      auto const upper = _mm_cmpgt_epi8(hi, seven);
+      auto const rows =
+          _mm_or_si128(_mm_andnot_si128(upper, _mm_shuffle_epi8(low, lo)),
+                       _mm_and_si128(upper, _mm_shuffle_epi8(high, lo)));
+      auto const hits =
+          ~static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+              _mm_and_si128(rows, _mm_shuffle_epi8(bits, hi)), zero))) &
+          0xFFFF;
+      if (hits)
+        return begin + __builtin_ctz(hits);
+    }
+#endif
+    return begin;
+  }
+#endif
+
+  std::uint16_t byte_class[256];
+  std::uint32_t classes;
+  bool is_first[256];
+  std::vector<std::uint8_t> first_bytes;
+  // nibble table rows of the start bytes, see skip_by_class
+  std::uint8_t first_low[16];
+  std::uint8_t first_high[16];
+
+  // transitions[state * classes + class]
+  std::vector<std::uint32_t> transitions;
+  // reporting state for every state (itself, or along its failure chain)
+  std::vector<std::uint32_t> output;
+  // the next reporting state along the failure chain of a reporting state
+  std::vector<std::uint32_t> output_link;
+  // pattern_ids[pattern_begin[s], pattern_begin[s+1]) end in state s
+  std::vector<std::uint32_t> pattern_begin;
+  std::vector<std::uint32_t> pattern_ids;
+  std::vector<std::size_t> lengths;
+
+  // stream state
+  std::uint32_t state;
+  std::uint64_t offset;
+};
+
+} // namespace strings
+} // namespace eopi
+
+#endif // EOPI_STRINGS_AHO_CORASICK_HPP_
@@ -4,31 +4,93 @@
 #include <algorithm>
 #include <bitset>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "bit_codes.hpp"
+#include "justify.hpp"
+
 namespace eopi {
 namespace strings {
 
-inline void remove_and_replace(std::size_t input_size, std::string &result) {
-  // remove 'b's
-  std::size_t output_pos = 0;
-  for (std::size_t i = 0; i < input_size; ++i) {
-    if (result[i] != 'b')
-      result[output_pos++] = result[i];
+namespace details {
+// number of bytes in [begin,end) equal to c
+inline std::size_t count_byte(char const *begin, char const *const end,
+                              char const c) {
+  std::size_t count = 0;
+#if defined(__AVX2__)
+  auto const splat = _mm256_set1_epi8(c);
+  for (; begin + 32 <= end; begin += 32)
+    count += static_cast<std::size_t>(__builtin_popcount(
+        static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(begin)),
+            splat)))));
+#elif defined(__SSE2__)
+  auto const splat = _mm_set1_epi8(c);
+  for (; begin + 16 <= end; begin += 16)
+    count += static_cast<std::size_t>(__builtin_popcount(
+        static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(begin)),
+            splat)))));
+#endif
+  return count + static_cast<std::size_t>(std::count(begin, end, c));
+}
+} // namespace details
+
+// in place on a caller buffer holding size bytes within capacity: removes
+// every 'b' and replaces every 'a' by "dd". Returns the new size, throws
+// without touching the buffer if the result does not fit
+inline std::size_t remove_and_replace(char *const buffer,
+                                      std::size_t const size,
+                                      std::size_t const capacity) {
+  auto const as = details::count_byte(buffer, buffer + size, 'a');
+  auto const bs = details::count_byte(buffer, buffer + size, 'b');
+  auto const result_size = size - bs + as;
+  if (result_size > capacity)
+    throw std::out_of_range("Buffer too small for the replacements");
+
+  // remove 'b's front to back, branch free
+  auto out = buffer;
+  for (auto itr = buffer; itr != buffer + size; ++itr) {
+    *out = *itr;
+    out += *itr != 'b';
   }
-  input_size = output_pos;
-  // look at the next char
-  output_pos = result.size() - 1;
-  while (input_size--) {
-    if (result[input_size] == 'a') {
-      // add to 'd's
-      result[output_pos--] = 'd';
-      result[output_pos--] = 'd';
+
+  // expand 'a's back to front, the write position never overtakes the read
+  if (as) {
+    auto write = buffer + result_size;
+    for (auto read = out; read != buffer;) {
+      auto const c = *--read;
+      if (c == 'a') {
+        *--write = 'd';
+        *--write = 'd';
+      } else {
+        *--write = c;
+      }
     }
   }
+  return result_size;
+}
+
+// the first input_size bytes of result are the input, result is sized to fit
+// the output and shrunk to the output size
+inline void remove_and_replace(std::size_t input_size, std::string &result) {
+  result.resize(remove_and_replace(&result[0], input_size, result.size()));
 }
 
 // check whether a given string is a palindrome
@@ -41,19 +103,88 @@ inline bool is_palindrom(std::string const &str) {
   return true;
 }
 
-inline std::string reverse_words(std::string sentence) {
-  std::reverse(sentence.begin(), sentence.end());
-
-  auto itr = sentence.begin();
-  auto end = sentence.begin();
-  while (end != sentence.end()) {
-    end = std::find(itr, sentence.end(), ' ');
-    std::reverse(itr, end);
-    itr = end == sentence.end() ? end : end + 1;
+namespace details {
+// reverse the bytes of [begin,end), swapping full vectors from both ends
+inline void reverse_bytes(char *begin, char *end) {
+#if defined(__AVX2__)
+  auto const mask = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4,
+                                     3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                     7, 6, 5, 4, 3, 2, 1, 0);
+  auto const reversed = [&mask](char const *from) {
+    auto const block =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const *>(from));
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(block, mask), 0x4E);
+  };
+  for (; end - begin >= 64; begin += 32) {
+    end -= 32;
+    auto const front = reversed(begin);
+    auto const back = reversed(end);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(begin), back);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(end), front);
   }
+#elif defined(__SSSE3__)
+  auto const mask =
+      _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  auto const reversed = [&mask](char const *from) {
+    return _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(from)), mask);
+  };
+  for (; end - begin >= 32; begin += 16) {
+    end -= 16;
+    auto const front = reversed(begin);
+    auto const back = reversed(end);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(begin), back);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(end), front);
+  }
+#endif
+  std::reverse(begin, end);
+}
+
+inline bool is_continuation(char const c) {
+  return (static_cast<std::uint8_t>(c) & 0xC0) == 0x80;
+}
+} // namespace details
+
+// reverse the order of the space separated words of [begin,end) in place.
+// Only the ASCII space separates words and the bytes of every word end up in
+// their original order, so UTF-8 text stays valid. The scan for spaces uses
+// memchr, which is vectorised by the C library
+inline void reverse_words(char *const begin, char *const end) {
+  details::reverse_bytes(begin, end);
+  for (auto itr = begin; itr != end;) {
+    auto space = static_cast<char *>(
+        std::memchr(itr, ' ', static_cast<std::size_t>(end - itr)));
+    if (!space)
+      space = end;
+    details::reverse_bytes(itr, space);
+    itr = space == end ? end : space + 1;
+  }
+}
+
+inline std::string reverse_words(std::string sentence) {
+  reverse_words(&sentence[0], &sentence[0] + sentence.size());
   return sentence;
 }
 
+// reverse the code points of valid UTF-8 text in place, keeping the bytes of
+// every multi-byte sequence in order
+inline void reverse_code_points(char *const begin, char *const end) {
+  details::reverse_bytes(begin, end);
+  // a reversed sequence is its continuation bytes followed by the lead byte
+  for (auto itr = begin; itr != end;) {
+    if (!details::is_continuation(*itr)) {
+      ++itr;
+      continue;
+    }
+    auto lead = itr;
+    while (lead != end && details::is_continuation(*lead))
+      ++lead;
+    auto const next = lead == end ? end : lead + 1;
+    std::reverse(itr, next);
+    itr = next;
+  }
+}
+
 inline void print_mnemonics_helper(std::uint32_t length, std::uint32_t digits,
                                    std::string mnemonic) {
   const static constexpr char chars[][10] = {{},
@@ -96,29 +227,160 @@ inline void print_mnemonics(std::uint32_t digits) {
 // runlength encoding/decoding for non-digit strings (no error checking,
 // requires valid input)
 namespace runlength {
+namespace details {
+// the end of the run of bytes equal to *begin, begin != end
+inline char const *run_end(char const *begin, char const *const end) {
+  auto const c = *begin++;
+#if defined(__AVX2__)
+  auto const splat = _mm256_set1_epi8(c);
+  for (; begin + 32 <= end; begin += 32) {
+    auto const block =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const *>(begin));
+    auto const differ = ~static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, splat)));
+    if (differ)
+      return begin + __builtin_ctz(differ);
+  }
+#elif defined(__SSE2__)
+  auto const splat = _mm_set1_epi8(c);
+  for (; begin + 16 <= end; begin += 16) {
+    auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(begin));
+    auto const differ = 0xFFFFu ^ static_cast<std::uint32_t>(_mm_movemask_epi8(
+                                      _mm_cmpeq_epi8(block, splat)));
+    if (differ)
+      return begin + __builtin_ctz(differ);
+  }
+#endif
+  while (begin != end && *begin == c)
+    ++begin;
+  return begin;
+}
+} // namespace details
+
 inline std::string encode(std::string const &str) {
-  std::ostringstream oss;
-  auto itr = str.begin();
-  while (itr != str.end()) {
-    auto end = std::find_if_not(itr, str.end(),
-                                [itr](char const c) { return c == *itr; });
-    oss << std::distance(itr, end) << *itr;
-    itr = end;
+  std::string result;
+  auto itr = str.data();
+  auto const end = str.data() + str.size();
+  while (itr != end) {
+    auto const run = details::run_end(itr, end);
+    result += std::to_string(run - itr);
+    result += *itr;
+    itr = run;
   }
-  return oss.str();
+  return result;
 }
 
 inline std::string decode(std::string const &str) {
-  std::istringstream iss(str);
-  std::ostringstream oss;
-  std::uint32_t count;
-  while (iss >> count) {
-    char c;
-    iss >> c;
-    while (count--)
-      oss << c;
+  std::string result;
+  for (std::size_t i = 0; i < str.size();) {
+    std::size_t count = 0;
+    for (; i < str.size() && str[i] >= '0' && str[i] <= '9'; ++i)
+      count = 10 * count + static_cast<std::size_t>(str[i] - '0');
+    if (i == str.size())
+      break;
+    result.append(count, str[i++]);
   }
-  return oss.str();
+  return result;
+}
+
+// Binary format: every run is stored as its byte followed by the run length
+// as varint. Both directions work on a stream of chunks, runs and varints may
+// straddle chunk borders.
+class BinaryEncoder {
+public:
+  BinaryEncoder() : current(0), length(0) {}
+
+  // append the runs completed within [begin,end) to out
+  void encode(char const *begin, char const *const end,
+              std::vector<std::uint8_t> &out) {
+    while (begin != end) {
+      if (length && *begin != current)
+        flush(out);
+      current = *begin;
+      auto const run = details::run_end(begin, end);
+      length += static_cast<std::uint64_t>(run - begin);
+      begin = run;
+    }
+  }
+
+  // append the last open run, the encoder can be reused afterwards
+  void finish(std::vector<std::uint8_t> &out) {
+    if (length)
+      flush(out);
+  }
+
+private:
+  void flush(std::vector<std::uint8_t> &out) {
+    out.push_back(static_cast<std::uint8_t>(current));
+    varint::write(out, length);
+    length = 0;
+  }
+
+  char current;
+  std::uint64_t length;
+};
+
+class BinaryDecoder {
+public:
+  BinaryDecoder() : has_byte(false), current(0), length(0), shift(0) {}
+
+  // append the runs decoded from [begin,end) to out, appending a run is a
+  // single memset
+  void decode(std::uint8_t const *begin, std::uint8_t const *const end,
+              std::string &out) {
+    while (begin != end) {
+      // fast path, a complete run (byte and varint of at most ten bytes)
+      if (!has_byte && end - begin > 10) {
+        auto const c = static_cast<char>(*begin++);
+        out.append(static_cast<std::size_t>(varint::read(begin)), c);
+        continue;
+      }
+
+      auto const byte = *begin++;
+      if (!has_byte) {
+        has_byte = true;
+        current = static_cast<char>(byte);
+        length = 0;
+        shift = 0;
+        continue;
+      }
+      length |= std::uint64_t{byte & 0x7Fu} << shift;
+      shift += 7;
+      if (byte < 0x80) {
+        out.append(static_cast<std::size_t>(length), current);
+        has_byte = false;
+      }
+    }
+  }
+
+private:
+  bool has_byte;
+  char current;
+  std::uint64_t length;
+  std::uint32_t shift;
+};
+
+inline std::vector<std::uint8_t> encode_binary(std::string const &str) {
+  std::vector<std::uint8_t> result;
+  BinaryEncoder encoder;
+  encoder.encode(str.data(), str.data() + str.size(), result);
+  encoder.finish(result);
+  return result;
+}
+
+inline std::string decode_binary(std::vector<std::uint8_t> const &encoded) {
+  // size the output once, so decoding never reallocates
+  std::uint64_t size = 0;
+  for (auto in = encoded.data(), end = in + encoded.size(); in != end;) {
+    ++in;
+    size += varint::read(in);
+  }
+
+  std::string result;
+  result.reserve(static_cast<std::size_t>(size));
+  BinaryDecoder decoder;
+  decoder.decode(encoded.data(), encoded.data() + encoded.size(), result);
+  return result;
 }
 } // namespace runlength
 
@@ -161,42 +423,10 @@ inline std::vector<std::uint32_t> decode(std::string const &encoded) {
 // print justified text
 inline void print_justified(std::vector<std::string> const &text,
                             std::uint32_t const justification) {
-  for (std::size_t pos = 0, end = 0; pos < text.size(); pos = end) {
-    std::uint32_t count = text[pos].size();
-    ++end;
-    while (end < text.size() && count + text[end].size() + 1 <= justification) {
-      count += text[end].size() + 1;
-      ++end;
-    }
-
-    // last line, print unjustified
-    if (end == text.size()) {
-      std::cout << text[pos];
-      for (auto i = pos + 1; i < end; ++i) {
-        std::cout << " " << text[i];
-      }
-      std::cout << std::endl;
-    } else // print justified
-    {
-      auto const n = end - pos;
-      auto const spaces = justification - count + n - 1;
-      auto const sep = spaces / (n - 1);
-
-      std::cout << text[pos];
-      for (auto i = 1; static_cast<std::size_t>(i) < n; ++i) {
-        // add spaces + additional one if we got a remainder
-        for (auto k = 0;
-             static_cast<std::size_t>(k) <
-             sep + ((static_cast<std::size_t>(i) - 1 < (spaces % (n - 1))) ? 1
-                                                                           : 0);
-             ++k)
-          std::cout << " ";
-
-        std::cout << text[pos + i];
-      }
-      std::cout << std::endl;
-    }
-  }
+  Justifier<OstreamSink> justifier(justification, OstreamSink(std::cout));
+  justifier.paragraph(text);
+  justifier.flush();
+  std::cout.flush();
 }
 
 // rabin karp string search, expecting only basic chars, can offer worse
@@ -253,6 +483,170 @@ inline std::size_t rabin_karp(const std::string &text,
   return std::string::npos;
 }
 
+namespace details {
+// maximal suffix of the pattern for the ordering given by `reversed`, returns
+// the position before the suffix and the period of the suffix
+inline std::pair<std::ptrdiff_t, std::ptrdiff_t>
+maximal_suffix(char const *pattern, std::ptrdiff_t const size,
+               bool const reversed) {
+  std::ptrdiff_t suffix = -1, j = 0, k = 1, period = 1;
+  while (j + k < size) {
+    auto const a = static_cast<unsigned char>(pattern[j + k]),
+               b = static_cast<unsigned char>(pattern[suffix + k]);
+    if (reversed ? a > b : a < b) {
+      j += k;
+      k = 1;
+      period = j - suffix;
+    } else if (a == b) {
+      if (k != period) {
+        ++k;
+      } else {
+        j += period;
+        k = 1;
+      }
+    } else {
+      suffix = j;
+      j = suffix + 1;
+      k = period = 1;
+    }
+  }
+  return {suffix, period};
+}
+
+// Crochemore-Perrin two-way matching: the pattern is split at its critical
+// factorisation, the right part is matched left to right, the left part right
+// to left. Linear time in the worst case and constant extra space
+inline std::size_t two_way(char const *text, std::ptrdiff_t const text_size,
+                           char const *pattern, std::ptrdiff_t const size) {
+  auto const forward = maximal_suffix(pattern, size, false),
+             backward = maximal_suffix(pattern, size, true);
+  auto const split = forward.first > backward.first ? forward : backward;
+  auto const ell = split.first;
+  auto period = split.second;
+
+  if (std::memcmp(pattern, pattern + period, ell + 1) == 0) {
+    // periodic pattern, remember the prefix already known to match
+    std::ptrdiff_t memory = -1;
+    for (std::ptrdiff_t j = 0; j <= text_size - size;) {
+      auto i = std::max(ell, memory) + 1;
+      while (i < size && pattern[i] == text[i + j])
+        ++i;
+      if (i >= size) {
+        i = ell;
+        while (i > memory && pattern[i] == text[i + j])
+          --i;
+        if (i <= memory)
+          return j;
+        j += period;
+        memory = size - period - 1;
+      } else {
+        j += i - ell;
+        memory = -1;
+      }
+    }
+  } else {
+    period = std::max(ell + 1, size - ell - 1) + 1;
+    for (std::ptrdiff_t j = 0; j <= text_size - size;) {
+      auto i = ell + 1;
+      while (i < size && pattern[i] == text[i + j])
+        ++i;
+      if (i >= size) {
+        i = ell;
+        while (i >= 0 && pattern[i] == text[i + j])
+          --i;
+        if (i < 0)
+          return j;
+        j += period;
+      } else {
+        j += i - ell;
+      }
+    }
+  }
+  return std::string::npos;
+}
+
+// compare the first and the last byte of the pattern against a block of
+// positions at once, only candidates passing both are verified
+inline std::size_t first_last_filter(char const *text, std::size_t text_size,
+                                     char const *pattern, std::size_t size) {
+  std::size_t pos = 0;
+  auto const verify = [&](std::size_t const at) {
+    return std::memcmp(text + at + 1, pattern + 1, size - 2) == 0;
+  };
+#if defined(__AVX2__)
+  auto const first = _mm256_set1_epi8(pattern[0]),
+             last = _mm256_set1_epi8(pattern[size - 1]);
+  for (; pos + size - 1 + 32 <= text_size; pos += 32) {
+    auto const starts =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const *>(text + pos));
+    auto const ends = _mm256_loadu_si256(
+        reinterpret_cast<__m256i const *>(text + pos + size - 1));
+    auto candidates = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(starts, first),
+                                              _mm256_cmpeq_epi8(ends, last))));
+    for (; candidates; candidates &= candidates - 1) {
+      auto const at = pos + __builtin_ctz(candidates);
+      if (verify(at))
+        return at;
+    }
+  }
+#elif defined(__SSE2__)
+  auto const first = _mm_set1_epi8(pattern[0]),
+             last = _mm_set1_epi8(pattern[size - 1]);
+  for (; pos + size - 1 + 16 <= text_size; pos += 16) {
+    auto const starts =
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(text + pos));
+    auto const ends = _mm_loadu_si128(
+        reinterpret_cast<__m128i const *>(text + pos + size - 1));
+    auto candidates = static_cast<std::uint32_t>(_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(starts, first), _mm_cmpeq_epi8(ends, last))));
+    for (; candidates; candidates &= candidates - 1) {
+      auto const at = pos + __builtin_ctz(candidates);
+      if (verify(at))
+        return at;
+    }
+  }
+#endif
+  for (; pos + size <= text_size; ++pos)
+    if (text[pos] == pattern[0] && text[pos + size - 1] == pattern[size - 1] &&
+        verify(pos))
+      return pos;
+  return std::string::npos;
+}
+} // namespace details
+
+// two-way string search, linear in the worst case
+inline std::size_t two_way(const std::string &text,
+                           const std::string &pattern) {
+  if (pattern.empty())
+    return 0;
+  if (pattern.size() > text.size())
+    return std::string::npos;
+  return details::two_way(text.data(), text.size(), pattern.data(),
+                          pattern.size());
+}
+
+// substring search choosing the kernel from the pattern length: memchr for
+// single chars, the vectorised first/last byte filter for short patterns and
+// two-way for long patterns, for which a filter can degrade to O(nm)
+inline std::size_t find(const std::string &text, const std::string &pattern) {
+  std::size_t const constexpr short_pattern = 32;
+  if (pattern.empty())
+    return 0;
+  if (pattern.size() > text.size())
+    return std::string::npos;
+  if (pattern.size() == 1) {
+    auto const match = static_cast<char const *>(
+        std::memchr(text.data(), pattern[0], text.size()));
+    return match ? match - text.data() : std::string::npos;
+  }
+  if (pattern.size() <= short_pattern)
+    return details::first_last_filter(text.data(), text.size(),
+                                      pattern.data(), pattern.size());
+  return details::two_way(text.data(), text.size(), pattern.data(),
+                          pattern.size());
+}
+
 } // namespace strings
 } // namespace eopi
 
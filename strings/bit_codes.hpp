@@ -0,0 +1,269 @@
+#ifndef EOPI_STRINGS_BIT_CODES_HPP_
+#define EOPI_STRINGS_BIT_CODES_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace eopi {
+namespace strings {
+
+// appends codes most significant bit first into a buffer of 64 bit words
+class BitWriter {
+public:
+  BitWriter() : current(0), used(0) {}
+
+  // write the lowest `bits` (<= 64) bits of value
+  void write(std::uint64_t value, std::uint32_t const bits) {
+    if (bits == 0)
+      return;
+    if (bits < 64)
+      value &= (std::uint64_t{1} << bits) - 1;
+    auto const free = 64 - used;
+    if (bits <= free) {
+      current |= value << (free - bits);
+      used += bits;
+      if (used == 64)
+        flush();
+    } else {
+      current |= value >> (bits - free);
+      flush();
+      used = bits - free;
+      current = value << (64 - used);
+    }
+  }
+
+  void write_zeros(std::uint64_t count) {
+    for (; count >= 64; count -= 64)
+      write(0, 64);
+    write(0, static_cast<std::uint32_t>(count));
+  }
+
+  // the written words, the last one padded with zeros
+  std::vector<std::uint64_t> finish() {
+    if (used)
+      flush();
+    return std::move(words);
+  }
+
+  void push_word(std::uint64_t const word) { words.push_back(word); }
+
+private:
+  void flush() {
+    words.push_back(current);
+    current = 0;
+    used = 0;
+  }
+
+  std::vector<std::uint64_t> words;
+  std::uint64_t current;
+  std::uint32_t used;
+};
+
+// reads codes written by the BitWriter
+class BitReader {
+public:
+  BitReader(std::uint64_t const *words, std::uint64_t const position = 0)
+      : words(words), position(position) {}
+
+  // read the next `bits` (<= 64) bits
+  std::uint64_t read(std::uint32_t const bits) {
+    if (bits == 0)
+      return 0;
+    auto const word = position >> 6;
+    auto const shift = position & 63;
+    auto value = words[word] << shift;
+    if (shift + bits > 64)
+      value |= words[word + 1] >> (64 - shift);
+    position += bits;
+    return value >> (64 - bits);
+  }
+
+  // consume all zeros up to the next set bit, which is not consumed
+  std::uint32_t read_zeros() {
+    std::uint32_t zeros = 0;
+    while (true) {
+      auto const shift = position & 63;
+      auto const value = words[position >> 6] << shift;
+      if (value) {
+        auto const leading = static_cast<std::uint32_t>(__builtin_clzll(value));
+        position += leading;
+        return zeros + leading;
+      }
+      zeros += static_cast<std::uint32_t>(64 - shift);
+      position += 64 - shift;
+    }
+  }
+
+  std::uint64_t tell() const { return position; }
+
+private:
+  std::uint64_t const *words;
+  std::uint64_t position;
+};
+
+// number of bits required to represent a value > 0
+inline std::uint32_t bit_width(std::uint64_t const value) {
+  return 64 - static_cast<std::uint32_t>(__builtin_clzll(value));
+}
+
+// All bit-packed codecs store the number of values in the first word, followed
+// by the codes.
+
+// values >= 1: floor(log2(v)) zeros followed by v in binary
+namespace elias_gamma_packed {
+inline void write(BitWriter &writer, std::uint64_t const value) {
+  auto const width = bit_width(value);
+  writer.write_zeros(width - 1);
+  writer.write(value, width);
+}
+
+inline std::uint64_t read(BitReader &reader) {
+  return reader.read(reader.read_zeros() + 1);
+}
+
+inline std::vector<std::uint64_t>
+encode(std::vector<std::uint32_t> const &data) {
+  BitWriter writer;
+  writer.push_word(data.size());
+  for (auto value : data)
+    write(writer, value);
+  return writer.finish();
+}
+
+inline std::vector<std::uint32_t>
+decode(std::vector<std::uint64_t> const &encoded) {
+  std::vector<std::uint32_t> result(encoded.front());
+  BitReader reader(encoded.data() + 1);
+  for (auto &value : result)
+    value = static_cast<std::uint32_t>(read(reader));
+  return result;
+}
+} // namespace elias_gamma_packed
+
+// values >= 1: the bit width of v in gamma code, followed by v without its
+// leading one
+namespace elias_delta {
+inline void write(BitWriter &writer, std::uint64_t const value) {
+  auto const width = bit_width(value);
+  elias_gamma_packed::write(writer, width);
+  writer.write(value, width - 1);
+}
+
+inline std::uint64_t read(BitReader &reader) {
+  auto const width =
+      static_cast<std::uint32_t>(elias_gamma_packed::read(reader));
+  return (std::uint64_t{1} << (width - 1)) | reader.read(width - 1);
+}
+
+inline std::vector<std::uint64_t>
+encode(std::vector<std::uint32_t> const &data) {
+  BitWriter writer;
+  writer.push_word(data.size());
+  for (auto value : data)
+    write(writer, value);
+  return writer.finish();
+}
+
+inline std::vector<std::uint32_t>
+decode(std::vector<std::uint64_t> const &encoded) {
+  std::vector<std::uint32_t> result(encoded.front());
+  BitReader reader(encoded.data() + 1);
+  for (auto &value : result)
+    value = static_cast<std::uint32_t>(read(reader));
+  return result;
+}
+} // namespace elias_delta
+
+// values >= 0 with parameter k: v >> k in unary (zeros terminated by a one),
+// followed by the lowest k bits. Optimal for geometric gaps with mean ~2^k
+namespace golomb_rice {
+inline void write(BitWriter &writer, std::uint64_t const value,
+                  std::uint32_t const k) {
+  writer.write_zeros(value >> k);
+  writer.write(1, 1);
+  writer.write(value, k);
+}
+
+inline std::uint64_t read(BitReader &reader, std::uint32_t const k) {
+  std::uint64_t const quotient = reader.read_zeros();
+  reader.read(1);
+  return (quotient << k) | reader.read(k);
+}
+
+// the parameter closest to log2 of the mean value
+inline std::uint32_t parameter(std::vector<std::uint32_t> const &data) {
+  std::uint64_t sum = 0;
+  for (auto value : data)
+    sum += value;
+  auto const mean = data.empty() ? 0 : sum / data.size();
+  return mean ? bit_width(mean) - 1 : 0;
+}
+
+// the parameter is stored in the second word
+inline std::vector<std::uint64_t>
+encode(std::vector<std::uint32_t> const &data) {
+  auto const k = parameter(data);
+  BitWriter writer;
+  writer.push_word(data.size());
+  writer.push_word(k);
+  for (auto value : data)
+    write(writer, value, k);
+  return writer.finish();
+}
+
+inline std::vector<std::uint32_t>
+decode(std::vector<std::uint64_t> const &encoded) {
+  std::vector<std::uint32_t> result(encoded[0]);
+  auto const k = static_cast<std::uint32_t>(encoded[1]);
+  BitReader reader(encoded.data() + 2);
+  for (auto &value : result)
+    value = static_cast<std::uint32_t>(read(reader, k));
+  return result;
+}
+} // namespace golomb_rice
+
+// byte aligned: seven bits per byte, the high bit marks a following byte
+namespace varint {
+inline void write(std::vector<std::uint8_t> &out, std::uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(value));
+}
+
+inline std::uint64_t read(std::uint8_t const *&in) {
+  std::uint64_t value = 0;
+  for (std::uint32_t shift = 0;; shift += 7) {
+    auto const byte = *in++;
+    value |= std::uint64_t{byte & 0x7Fu} << shift;
+    if (byte < 0x80)
+      return value;
+  }
+}
+
+inline std::vector<std::uint8_t> encode(std::vector<std::uint32_t> const &data) {
+  std::vector<std::uint8_t> result;
+  result.reserve(data.size() + 8);
+  write(result, data.size());
+  for (auto value : data)
+    write(result, value);
+  return result;
+}
+
+inline std::vector<std::uint32_t>
+decode(std::vector<std::uint8_t> const &encoded) {
+  auto in = encoded.data();
+  std::vector<std::uint32_t> result(read(in));
+  for (auto &value : result)
+    value = static_cast<std::uint32_t>(read(in));
+  return result;
+}
+} // namespace varint
+
+} // namespace strings
+} // namespace eopi
+
+#endif // EOPI_STRINGS_BIT_CODES_HPP_
@@ -0,0 +1,384 @@
+#ifndef EOPI_STRINGS_INTEGER_CODECS_HPP_
+#define EOPI_STRINGS_INTEGER_CODECS_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "bit_codes.hpp"
+
+namespace eopi {
+namespace strings {
+
+// Block codecs for sorted integer lists. Every codec encodes a block of
+// BLOCK_SIZE deltas and decodes them again:
+//   static void encode(std::uint32_t const *deltas, std::vector<std::uint8_t> &out);
+//   static std::uint8_t const *decode(std::uint8_t const *in, std::uint32_t *deltas);
+// Decoders may read up to CODEC_PADDING bytes past the end of their block.
+std::size_t const constexpr BLOCK_SIZE = 128;
+std::size_t const constexpr CODEC_PADDING = 16;
+
+namespace details {
+inline std::uint32_t max_width(std::uint32_t const *values,
+                               std::size_t const count) {
+  std::uint32_t any = 0;
+  for (std::size_t i = 0; i < count; ++i)
+    any |= values[i];
+  return any ? bit_width(any) : 0;
+}
+
+// horizontal little endian bit packing of BLOCK_SIZE values of `bits` each
+inline void pack(std::uint32_t const *values, std::uint32_t const bits,
+                 std::vector<std::uint8_t> &out) {
+  std::uint64_t buffer = 0;
+  std::uint32_t used = 0;
+  for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+    buffer |= std::uint64_t{values[i]} << used;
+    for (used += bits; used >= 8; used -= 8, buffer >>= 8)
+      out.push_back(static_cast<std::uint8_t>(buffer));
+  }
+}
+
+inline std::uint8_t const *unpack(std::uint8_t const *in,
+                                  std::uint32_t const bits,
+                                  std::uint32_t *values) {
+  auto const mask = bits == 32 ? ~std::uint32_t{0}
+                               : (std::uint32_t{1} << bits) - 1;
+  std::uint64_t buffer = 0;
+  std::uint32_t available = 0;
+  for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+    for (; available < bits; available += 8)
+      buffer |= std::uint64_t{*in++} << available;
+    values[i] = static_cast<std::uint32_t>(buffer) & mask;
+    buffer >>= bits;
+    available -= bits;
+  }
+  return in;
+}
+
+// inclusive prefix sum of a block, starting from base
+inline void prefix_sum(std::uint32_t *values, std::uint32_t const base) {
+#if defined(__SSE2__)
+  auto carry = _mm_set1_epi32(static_cast<int>(base));
+  for (std::size_t i = 0; i < BLOCK_SIZE; i += 4) {
+    auto block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(values + i));
+    block = _mm_add_epi32(block, _mm_slli_si128(block, 4));
+    block = _mm_add_epi32(block, _mm_slli_si128(block, 8));
+    block = _mm_add_epi32(block, carry);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(values + i), block);
+    carry = _mm_shuffle_epi32(block, 0xFF);
+  }
+#else
+  auto sum = base;
+  for (std::size_t i = 0; i < BLOCK_SIZE; ++i)
+    values[i] = sum += values[i];
+#endif
+}
+
+// shuffle masks spreading the four integers of a Stream VByte control byte
+struct StreamVByteLookupTable {
+  constexpr StreamVByteLookupTable() : shuffle(), length() {
+    for (std::uint32_t control = 0; control < 256; ++control) {
+      std::uint8_t offset = 0;
+      for (std::uint32_t value = 0; value < 4; ++value) {
+        auto const bytes = ((control >> (2 * value)) & 3) + 1;
+        for (std::uint32_t byte = 0; byte < 4; ++byte)
+          shuffle[control][4 * value + byte] =
+              byte < bytes ? offset + byte : 0x80;
+        offset += bytes;
+      }
+      length[control] = offset;
+    }
+  }
+
+  std::uint8_t shuffle[256][16];
+  std::uint8_t length[256];
+};
+} // namespace details
+
+// frame of reference: all deltas with the bit width of the largest one
+struct ForCodec {
+  static void encode(std::uint32_t const *deltas,
+                     std::vector<std::uint8_t> &out) {
+    auto const bits = details::max_width(deltas, BLOCK_SIZE);
+    out.push_back(static_cast<std::uint8_t>(bits));
+    details::pack(deltas, bits, out);
+  }
+
+  static std::uint8_t const *decode(std::uint8_t const *in,
+                                    std::uint32_t *deltas) {
+    auto const bits = *in++;
+    return details::unpack(in, bits, deltas);
+  }
+};
+
+// patched frame of reference: the width is chosen for the bulk of the
+// deltas, the high bits of the few outliers are stored as exceptions
+struct PforCodec {
+  static void encode(std::uint32_t const *deltas,
+                     std::vector<std::uint8_t> &out) {
+    std::uint32_t counts[33] = {};
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i)
+      ++counts[deltas[i] ? bit_width(deltas[i]) : 0];
+
+    // cost in bytes for every width, an exception costs ~ position + varint
+    std::uint32_t bits = 32, best = ~std::uint32_t{0}, exceptions = 0;
+    for (std::uint32_t width = 33; width-- > 0;) {
+      auto const cost = 16 * width + 4 * exceptions;
+      if (cost < best && exceptions < 256) {
+        best = cost;
+        bits = width;
+      }
+      exceptions += counts[width];
+    }
+
+    std::uint32_t lows[BLOCK_SIZE];
+    std::vector<std::uint8_t> positions;
+    auto const mask = bits == 32 ? ~std::uint32_t{0}
+                                 : (std::uint32_t{1} << bits) - 1;
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+      lows[i] = deltas[i] & mask;
+      if (deltas[i] != lows[i])
+        positions.push_back(static_cast<std::uint8_t>(i));
+    }
+
+    out.push_back(static_cast<std::uint8_t>(bits));
+    out.push_back(static_cast<std::uint8_t>(positions.size()));
+    details::pack(lows, bits, out);
+    for (auto position : positions) {
+      out.push_back(position);
+      varint::write(out, deltas[position] >> bits);
+    }
+  }
+
+  static std::uint8_t const *decode(std::uint8_t const *in,
+                                    std::uint32_t *deltas) {
+    auto const bits = in[0], exceptions = in[1];
+    in = details::unpack(in + 2, bits, deltas);
+    for (std::uint32_t i = 0; i < exceptions; ++i) {
+      auto const position = *in++;
+      deltas[position] |= static_cast<std::uint32_t>(varint::read(in)) << bits;
+    }
+    return in;
+  }
+};
+
+// Stream VByte: two bit lengths of four integers per control byte, followed
+// by the data bytes. Decoding spreads four integers with a single shuffle
+struct StreamVByteCodec {
+  static void encode(std::uint32_t const *deltas,
+                     std::vector<std::uint8_t> &out) {
+    auto const control = out.size();
+    out.resize(out.size() + BLOCK_SIZE / 4, 0);
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+      std::uint32_t bytes = 1;
+      while (bytes < 4 && (deltas[i] >> (8 * bytes)))
+        ++bytes;
+      out[control + i / 4] |= static_cast<std::uint8_t>((bytes - 1)
+                                                        << (2 * (i % 4)));
+      for (std::uint32_t byte = 0; byte < bytes; ++byte)
+        out.push_back(static_cast<std::uint8_t>(deltas[i] >> (8 * byte)));
+    }
+  }
+
+  static std::uint8_t const *decode(std::uint8_t const *in,
+                                    std::uint32_t *deltas) {
+    static const details::StreamVByteLookupTable lookup;
+    auto data = in + BLOCK_SIZE / 4;
+    for (std::size_t i = 0; i < BLOCK_SIZE / 4; ++i) {
+      auto const control = in[i];
+#if defined(__SSSE3__)
+      auto const bytes =
+          _mm_loadu_si128(reinterpret_cast<__m128i const *>(data));
+      auto const shuffle = _mm_loadu_si128(
+          reinterpret_cast<__m128i const *>(lookup.shuffle[control]));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(deltas + 4 * i),
+                       _mm_shuffle_epi8(bytes, shuffle));
+#else
+      for (std::uint32_t value = 0; value < 4; ++value) {
+        std::uint32_t decoded = 0;
+        for (std::uint32_t byte = 0; byte < 4; ++byte) {
+          auto const from = lookup.shuffle[control][4 * value + byte];
+          if (from != 0x80)
+            decoded |= std::uint32_t{data[from]} << (8 * byte);
+        }
+        deltas[4 * i + value] = decoded;
+      }
+#endif
+      data += lookup.length[control];
+    }
+    return data;
+  }
+};
+
+// SIMD-BP128: the deltas are packed vertically, value 4i+j into lane j of
+// the i-th row, so four lanes are packed / unpacked with every vector shift
+struct Bp128Codec {
+  static void encode(std::uint32_t const *deltas,
+                     std::vector<std::uint8_t> &out) {
+    auto const bits = details::max_width(deltas, BLOCK_SIZE);
+    out.push_back(static_cast<std::uint8_t>(bits));
+
+    std::uint32_t words[BLOCK_SIZE];
+    for (std::uint32_t lane = 0; lane < 4; ++lane) {
+      std::uint32_t accumulator = 0, used = 0, word = 0;
+      for (std::uint32_t row = 0; row < 32 && bits; ++row) {
+        auto const value = deltas[4 * row + lane];
+        accumulator |= value << used;
+        used += bits;
+        if (used >= 32) {
+          words[4 * word++ + lane] = accumulator;
+          used -= 32;
+          accumulator = used ? value >> (bits - used) : 0;
+        }
+      }
+    }
+    auto const bytes = reinterpret_cast<std::uint8_t const *>(words);
+    out.insert(out.end(), bytes, bytes + 16 * bits);
+  }
+
+  static std::uint8_t const *decode(std::uint8_t const *in,
+                                    std::uint32_t *deltas) {
+    auto const bits = *in++;
+    if (bits == 0) {
+      std::fill(deltas, deltas + BLOCK_SIZE, 0);
+      return in;
+    }
+#if defined(__SSE2__)
+    auto const mask = _mm_set1_epi32(
+        bits == 32 ? -1 : static_cast<int>((std::uint32_t{1} << bits) - 1));
+    auto const load = [&in]() {
+      auto const word = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in));
+      in += 16;
+      return word;
+    };
+    auto word = load();
+    std::uint32_t used = 0;
+    for (std::uint32_t row = 0; row < 32; ++row) {
+      auto value = _mm_srl_epi32(word, _mm_cvtsi32_si128(used));
+      used += bits;
+      if (used >= 32) {
+        used -= 32;
+        if (row + 1 < 32 || used)
+          word = load();
+        if (used)
+          value = _mm_or_si128(
+              value, _mm_sll_epi32(word, _mm_cvtsi32_si128(bits - used)));
+      }
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(deltas + 4 * row),
+                       _mm_and_si128(value, mask));
+    }
+#else
+    auto const mask = bits == 32 ? ~std::uint32_t{0}
+                                 : (std::uint32_t{1} << bits) - 1;
+    std::uint32_t words[BLOCK_SIZE];
+    std::memcpy(words, in, 16 * bits);
+    in += 16 * bits;
+    for (std::uint32_t lane = 0; lane < 4; ++lane) {
+      std::uint32_t used = 0, word = 0;
+      for (std::uint32_t row = 0; row < 32; ++row) {
+        auto value = used < 32 ? words[4 * word + lane] >> used : 0;
+        used += bits;
+        if (used >= 32) {
+          used -= 32;
+          ++word;
+          if (used)
+            value |= words[4 * word + lane] << (bits - used);
+        }
+        deltas[4 * row + lane] = value & mask;
+      }
+    }
+#endif
+    return in;
+  }
+};
+
+// a sorted list of integers, compressed in blocks of BLOCK_SIZE deltas. A skip
+// pointer per block (first value and byte offset) allows random access and
+// searches that only decode a single block
+template <typename codec_type> class CompressedPostings {
+public:
+  explicit CompressedPostings(std::vector<std::uint32_t> const &sorted)
+      : count(sorted.size()) {
+    std::uint32_t deltas[BLOCK_SIZE];
+    for (std::size_t begin = 0; begin < sorted.size(); begin += BLOCK_SIZE) {
+      auto const end = std::min(begin + BLOCK_SIZE, sorted.size());
+      skips.push_back({sorted[begin], static_cast<std::uint64_t>(data.size())});
+      deltas[0] = 0;
+      for (auto i = begin + 1; i < end; ++i)
+        deltas[i - begin] = sorted[i] - sorted[i - 1];
+      std::fill(deltas + (end - begin), deltas + BLOCK_SIZE, 0);
+      codec_type::encode(deltas, data);
+    }
+    data.resize(data.size() + CODEC_PADDING, 0);
+  }
+
+  std::size_t size() const { return count; }
+
+  // compressed size in bytes, including the skip pointers
+  std::size_t bytes() const {
+    return data.size() - CODEC_PADDING + skips.size() * sizeof(Skip);
+  }
+
+  std::vector<std::uint32_t> decode() const {
+    std::vector<std::uint32_t> result(skips.size() * BLOCK_SIZE);
+    for (std::size_t block = 0; block < skips.size(); ++block)
+      decode_block(block, result.data() + block * BLOCK_SIZE);
+    result.resize(count);
+    return result;
+  }
+
+  std::uint32_t at(std::size_t const index) const {
+    std::uint32_t values[BLOCK_SIZE];
+    decode_block(index / BLOCK_SIZE, values);
+    return values[index % BLOCK_SIZE];
+  }
+
+  // index of the first value >= value (size() if there is none), decoding
+  // only the block selected by the skip pointers
+  std::size_t lower_bound(std::uint32_t const value) const {
+    // the last block starting below value, equal values may straddle blocks
+    auto const skip = std::lower_bound(
+        skips.begin(), skips.end(), value,
+        [](Skip const &lhs, std::uint32_t rhs) { return lhs.first < rhs; });
+    if (skip == skips.begin())
+      return 0;
+
+    auto const block = static_cast<std::size_t>(skip - skips.begin()) - 1;
+    std::uint32_t values[BLOCK_SIZE];
+    decode_block(block, values);
+    auto const in_block =
+        std::min(BLOCK_SIZE, count - block * BLOCK_SIZE);
+    auto const pos =
+        std::lower_bound(values, values + in_block, value) - values;
+    return block * BLOCK_SIZE + pos;
+  }
+
+private:
+  struct Skip {
+    std::uint32_t first;
+    std::uint64_t offset;
+  };
+
+  void decode_block(std::size_t const block, std::uint32_t *values) const {
+    codec_type::decode(data.data() + skips[block].offset, values);
+    details::prefix_sum(values, skips[block].first);
+  }
+
+  std::size_t count;
+  std::vector<Skip> skips;
+  std::vector<std::uint8_t> data;
+};
+
+} // namespace strings
+} // namespace eopi
+
+#endif // EOPI_STRINGS_INTEGER_CODECS_HPP_
@@ -0,0 +1,202 @@
+#ifndef EOPI_STRINGS_JUSTIFY_HPP_
+#define EOPI_STRINGS_JUSTIFY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace eopi {
+namespace strings {
+
+// greedy fills every line as far as possible, minimum raggedness (Knuth-Plass)
+// minimises the sum of squared trailing spaces over all but the last line
+enum class Layout { greedy, minimum_raggedness };
+
+namespace details {
+// length of words[begin,end) separated by single spaces
+inline std::size_t line_length(std::vector<std::size_t> const &prefix,
+                               std::size_t const begin, std::size_t const end) {
+  return prefix[end] - prefix[begin] + (end - begin - 1);
+}
+
+// the end of every line, a word longer than the width gets its own line
+inline std::vector<std::size_t>
+greedy_breaks(std::vector<std::string> const &words, std::size_t const width) {
+  std::vector<std::size_t> breaks;
+  for (std::size_t pos = 0, end = 0; pos < words.size(); pos = end) {
+    auto count = words[pos].size();
+    for (++end; end < words.size() && count + words[end].size() + 1 <= width;
+         ++end)
+      count += words[end].size() + 1;
+    breaks.push_back(end);
+  }
+  return breaks;
+}
+
+inline std::vector<std::size_t>
+minimum_raggedness_breaks(std::vector<std::string> const &words,
+                          std::size_t const width) {
+  auto const n = words.size();
+  std::vector<std::size_t> prefix(n + 1, 0);
+  for (std::size_t i = 0; i < n; ++i)
+    prefix[i + 1] = prefix[i] + words[i].size();
+
+  // cost[i]: cheapest layout of words[i,n), next[i]: end of its first line
+  std::vector<std::uint64_t> cost(n + 1, 0);
+  std::vector<std::size_t> next(n + 1, n);
+  for (auto i = n; i-- > 0;) {
+    cost[i] = std::numeric_limits<std::uint64_t>::max();
+    for (auto end = i + 1; end <= n; ++end) {
+      auto const length = line_length(prefix, i, end);
+      if (length > width && end > i + 1)
+        break;
+      auto const slack = length < width ? width - length : 0;
+      auto const line = end == n ? 0 : std::uint64_t{slack} * slack;
+      if (line + cost[end] < cost[i]) {
+        cost[i] = line + cost[end];
+        next[i] = end;
+      }
+    }
+  }
+
+  std::vector<std::size_t> breaks;
+  for (std::size_t i = 0; i < n; i = next[i])
+    breaks.push_back(next[i]);
+  return breaks;
+}
+} // namespace details
+
+// writes justified paragraphs into an output buffer, which is handed to the
+// sink, any callable sink(char const *data, std::size_t size), whenever it
+// exceeds buffer_size bytes and on flush
+template <typename sink_type> class Justifier {
+public:
+  Justifier(std::size_t const width, sink_type sink,
+            Layout const layout = Layout::greedy,
+            std::size_t const buffer_size = 1 << 16)
+      : width(width), sink(sink), layout(layout), buffer_size(buffer_size) {
+    buffer.reserve(buffer_size + width + 1);
+  }
+
+  Justifier(Justifier const &) = delete;
+  Justifier &operator=(Justifier const &) = delete;
+
+  ~Justifier() { flush(); }
+
+  // justify a paragraph, every line is padded to the width except the last
+  void paragraph(std::vector<std::string> const &words) {
+    auto const breaks = layout == Layout::greedy
+                            ? details::greedy_breaks(words, width)
+                            : details::minimum_raggedness_breaks(words, width);
+    std::size_t begin = 0;
+    for (auto end : breaks) {
+      write_line(words, begin, end, end == words.size());
+      begin = end;
+    }
+  }
+
+  void blank_line() { append_newline(); }
+
+  void flush() {
+    if (!buffer.empty())
+      sink(buffer.data(), buffer.size());
+    buffer.clear();
+  }
+
+private:
+  void write_line(std::vector<std::string> const &words,
+                  std::size_t const begin, std::size_t const end,
+                  bool const last) {
+    std::size_t chars = 0;
+    for (auto i = begin; i < end; ++i)
+      chars += words[i].size();
+    auto const gaps = end - begin - 1;
+    auto const spaces =
+        last ? gaps : (chars + gaps < width ? width - chars : gaps);
+
+    buffer += words[begin];
+    for (auto i = begin + 1; i < end; ++i) {
+      // the remainder goes to the leftmost gaps
+      auto const gap = i - begin - 1;
+      buffer.append(spaces / gaps + (gap < spaces % gaps ? 1 : 0), ' ');
+      buffer += words[i];
+    }
+    if (!last && gaps == 0 && chars < width)
+      buffer.append(width - chars, ' ');
+    append_newline();
+  }
+
+  void append_newline() {
+    buffer += '\n';
+    if (buffer.size() >= buffer_size)
+      flush();
+  }
+
+  std::size_t width;
+  sink_type sink;
+  Layout layout;
+  std::size_t buffer_size;
+  std::string buffer;
+};
+
+// sink writing into an output stream
+struct OstreamSink {
+  explicit OstreamSink(std::ostream &out) : out(&out) {}
+
+  void operator()(char const *data, std::size_t const size) const {
+    out->write(data, static_cast<std::streamsize>(size));
+  }
+
+  std::ostream *out;
+};
+
+// justify text read from a stream paragraph by paragraph (separated by blank
+// lines), keeping only the current paragraph in memory
+template <typename sink_type>
+void justify_stream(std::istream &input, std::size_t const width,
+                    sink_type sink, Layout const layout = Layout::greedy) {
+  Justifier<sink_type> justifier(width, sink, layout);
+  std::vector<std::string> words;
+  bool first = true;
+  auto const finish_paragraph = [&]() {
+    if (words.empty())
+      return;
+    if (!first)
+      justifier.blank_line();
+    justifier.paragraph(words);
+    words.clear();
+    first = false;
+  };
+
+  std::string line;
+  while (std::getline(input, line)) {
+    auto const is_space = [](char const c) {
+      return c == ' ' || c == '\t' || c == '\r';
+    };
+    bool blank = true;
+    for (std::size_t pos = 0; pos < line.size();) {
+      while (pos < line.size() && is_space(line[pos]))
+        ++pos;
+      auto end = pos;
+      while (end < line.size() && !is_space(line[end]))
+        ++end;
+      if (end > pos) {
+        words.emplace_back(line, pos, end - pos);
+        blank = false;
+      }
+      pos = end;
+    }
+    if (blank)
+      finish_paragraph();
+  }
+  finish_paragraph();
+}
+
+} // namespace strings
+} // namespace eopi
+
+#endif // EOPI_STRINGS_JUSTIFY_HPP_
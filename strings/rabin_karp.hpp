@@ -0,0 +1,127 @@
+#ifndef EOPI_STRINGS_RABIN_KARP_HPP_
+#define EOPI_STRINGS_RABIN_KARP_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace eopi {
+namespace strings {
+
+// rabin karp search over a stream of byte spans of arbitrary size. Only the
+// last pattern-size bytes of the previous chunks are kept, so the text never
+// has to be resident as a whole and matches may straddle chunk borders. Any
+// contiguous span works as input, e.g. an mmapped file.
+class RabinKarpStream {
+public:
+  explicit RabinKarpStream(std::string pattern)
+      : pattern(std::move(pattern)), pattern_hash(0), max_power(1), hash(0),
+        filled(0), offset(0) {
+    for (std::size_t i = 1; i < this->pattern.size(); ++i)
+      max_power = (max_power * base) % modul;
+    for (auto c : this->pattern)
+      pattern_hash = (pattern_hash * base + static_cast<std::uint8_t>(c)) % modul;
+  }
+
+  // feed the next chunk of the stream. Calls on_match(position) for every
+  // match ending in this chunk, position being the offset of the first byte of
+  // the match within the whole stream
+  template <typename functor>
+  void scan(char const *const begin, char const *const end, functor on_match) {
+    auto const size = static_cast<std::ptrdiff_t>(end - begin);
+    auto const length = static_cast<std::ptrdiff_t>(pattern.size());
+    if (length == 0)
+      return;
+
+    // negative positions refer to the bytes carried over from earlier chunks
+    auto const at = [&](std::ptrdiff_t const pos) {
+      return static_cast<std::uint8_t>(pos < 0 ? carry[carry.size() + pos]
+                                               : begin[pos]);
+    };
+
+    for (std::ptrdiff_t pos = 0; pos < size; ++pos) {
+      if (filled == pattern.size())
+        hash = (hash + modul - (at(pos - length) * max_power) % modul) % modul;
+      else
+        ++filled;
+      hash = (hash * base + static_cast<std::uint8_t>(begin[pos])) % modul;
+
+      auto const start = pos + 1 - length;
+      if (filled == pattern.size() && hash == pattern_hash && matches(begin, start))
+        on_match(offset + pos + 1 - length);
+    }
+
+    // remember the window for the next chunk
+    if (size >= length) {
+      carry.assign(end - length, end);
+    } else {
+      carry.append(begin, end);
+      if (carry.size() > pattern.size())
+        carry.erase(0, carry.size() - pattern.size());
+    }
+    offset += size;
+  }
+
+  template <typename functor>
+  void scan(std::string const &chunk, functor on_match) {
+    scan(chunk.data(), chunk.data() + chunk.size(), on_match);
+  }
+
+  // start a new stream
+  void reset() {
+    hash = 0;
+    filled = 0;
+    offset = 0;
+    carry.clear();
+  }
+
+private:
+  // verify a hash match, the window may start within the carried bytes
+  bool matches(char const *begin, std::ptrdiff_t const start) const {
+    if (start >= 0)
+      return std::memcmp(begin + start, pattern.data(), pattern.size()) == 0;
+
+    auto const carried = static_cast<std::size_t>(-start);
+    return std::memcmp(carry.data() + carry.size() - carried, pattern.data(),
+                       carried) == 0 &&
+           std::memcmp(begin, pattern.data() + carried,
+                       pattern.size() - carried) == 0;
+  }
+
+  static const constexpr std::uint64_t modul = 1000000007;
+  static const constexpr std::uint64_t base = 257;
+
+  std::string pattern;
+  std::uint64_t pattern_hash;
+  std::uint64_t max_power;
+
+  // stream state
+  std::uint64_t hash;
+  std::size_t filled;
+  std::uint64_t offset;
+  std::string carry;
+};
+
+// drive a streaming matcher from an input stream in fixed-size chunks, using
+// constant memory independent of the stream size
+template <typename matcher_type, typename functor>
+void scan_stream(std::istream &input, matcher_type &matcher, functor on_match,
+                 std::size_t const chunk_size = 1 << 16) {
+  std::vector<char> buffer(chunk_size);
+  while (input) {
+    input.read(buffer.data(), buffer.size());
+    auto const count = input.gcount();
+    if (count > 0)
+      matcher.scan(buffer.data(), buffer.data() + count, on_match);
+  }
+}
+
+} // namespace strings
+} // namespace eopi
+
+#endif // EOPI_STRINGS_RABIN_KARP_HPP_
@@ -2,8 +2,11 @@
 #define EOPI_STRINGS_RANDOM_HPP_
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 
 namespace eopi {
@@ -27,49 +30,95 @@ inline std::string look_and_say(std::uint32_t n) {
   return current;
 }
 
-// roman numeral to int
-inline std::uint32_t from_roman(std::string const numerals) {
-  // M -> 1000
-  // D -> 500
-  // C -> 100
-  // L -> 50
-  // X -> 10
-  // V -> 5
-  // I -> 1
-  auto const to_number = [](auto const c) {
-    switch (c) {
-    case 'M':
-      return 1000;
-    case 'D':
-      return 500;
-    case 'C':
-      return 100;
-    case 'L':
-      return 50;
-    case 'X':
-      return 10;
-    case 'V':
-      return 5;
-    case 'I':
-      return 1;
-    default:
-      return 0;
-    }
-  };
-
-  auto last = 0;
-  std::uint32_t total = 0;
-  for (auto itr = numerals.rbegin(); itr != numerals.rend(); ++itr) {
-    auto cur = to_number(*itr);
-    if (cur < last)
-      total -= cur;
-    else
-      total += cur;
-    last = cur;
+namespace details {
+// value of every roman numeral character, 0 for all other characters
+struct RomanLookupTable {
+  constexpr RomanLookupTable() : value() {
+    value['M'] = 1000;
+    value['D'] = 500;
+    value['C'] = 100;
+    value['L'] = 50;
+    value['X'] = 10;
+    value['V'] = 5;
+    value['I'] = 1;
+  }
+
+  std::uint16_t value[256];
+};
+} // namespace details
+
+// roman numeral to int, a numeral smaller than its successor is subtracted
+inline std::uint32_t from_roman(char const *begin, char const *const end) {
+  static const details::RomanLookupTable roman;
+  std::uint32_t total = 0, last = 0;
+  for (; begin != end; ++begin) {
+    std::uint32_t const current =
+        roman.value[static_cast<std::uint8_t>(*begin)];
+    total += current;
+    // the previous numeral was added, but should have been subtracted
+    if (last < current)
+      total -= 2 * last;
+    last = current;
   }
   return total;
 }
 
+inline std::uint32_t from_roman(std::string const &numerals) {
+  return from_roman(numerals.data(), numerals.data() + numerals.size());
+}
+
+// batch decoding of delimited numerals into out, returns the number of
+// numerals. An empty field after the last delimiter is skipped
+inline std::size_t from_roman(char const *begin, char const *const end,
+                              char const delimiter, std::uint32_t *const out) {
+  std::size_t count = 0;
+  while (begin != end) {
+    auto field_end = static_cast<char const *>(
+        std::memchr(begin, delimiter, static_cast<std::size_t>(end - begin)));
+    if (!field_end)
+      field_end = end;
+    out[count++] = from_roman(begin, field_end);
+    begin = field_end == end ? end : field_end + 1;
+  }
+  return count;
+}
+
+// int in [0,3999] to roman numerals into out, which needs room for 15 bytes.
+// Returns the end of the output
+inline char *to_roman(std::uint32_t value, char *out) {
+  static const char *const digits[4][10] = {
+      {"", "I", "II", "III", "IV", "V", "VI", "VII", "VIII", "IX"},
+      {"", "X", "XX", "XXX", "XL", "L", "LX", "LXX", "LXXX", "XC"},
+      {"", "C", "CC", "CCC", "CD", "D", "DC", "DCC", "DCCC", "CM"},
+      {"", "M", "MM", "MMM"}};
+  if (value > 3999)
+    throw std::out_of_range("Roman numerals only cover up to 3999");
+
+  std::uint32_t const thousands = value / 1000, hundreds = value / 100 % 10,
+                      tens = value / 10 % 10, ones = value % 10;
+  for (auto digit : {digits[3][thousands], digits[2][hundreds],
+                     digits[1][tens], digits[0][ones]})
+    while (*digit)
+      *out++ = *digit++;
+  return out;
+}
+
+inline std::string to_roman(std::uint32_t const value) {
+  char buffer[15];
+  return std::string(buffer, to_roman(value, buffer));
+}
+
+// batch encoding of values, every numeral is terminated by delimiter
+inline char *to_roman(std::uint32_t const *begin,
+                      std::uint32_t const *const end, char const delimiter,
+                      char *out) {
+  for (; begin != end; ++begin) {
+    out = to_roman(*begin, out);
+    *out++ = delimiter;
+  }
+  return out;
+}
+
 inline void ip_helper(std::uint32_t to_place, std::uint32_t pos,
                       std::string const &str, int placements[3]) {
   // can use at least three digits per dot
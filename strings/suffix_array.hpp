@@ -0,0 +1,257 @@
+#ifndef EOPI_STRINGS_SUFFIX_ARRAY_HPP_
+#define EOPI_STRINGS_SUFFIX_ARRAY_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../parallel/chunks.hpp"
+
+namespace eopi {
+namespace strings {
+
+namespace details {
+// SA-IS: linear time suffix sorting by induced sorting of the LMS suffixes,
+// symbols of s are within [0,upper]
+inline std::vector<std::int32_t> sa_is(std::vector<std::int32_t> const &s,
+                                       std::int32_t const upper) {
+  auto const n = static_cast<std::int32_t>(s.size());
+  if (n == 0)
+    return {};
+  if (n == 1)
+    return {0};
+  if (n == 2)
+    return s[0] < s[1] ? std::vector<std::int32_t>{0, 1}
+                       : std::vector<std::int32_t>{1, 0};
+
+  // is_s[i]: suffix i is smaller than suffix i + 1
+  std::vector<std::int32_t> sa(n);
+  std::vector<bool> is_s(n, false);
+  for (auto i = n - 2; i >= 0; --i)
+    is_s[i] = s[i] == s[i + 1] ? is_s[i + 1] : s[i] < s[i + 1];
+
+  // bucket starts of the L and S suffixes of every symbol
+  std::vector<std::int32_t> sum_l(upper + 1, 0), sum_s(upper + 1, 0);
+  for (std::int32_t i = 0; i < n; ++i) {
+    if (!is_s[i])
+      ++sum_s[s[i]];
+    else
+      ++sum_l[s[i] + 1];
+  }
+  for (std::int32_t c = 0; c <= upper; ++c) {
+    sum_s[c] += sum_l[c];
+    if (c < upper)
+      sum_l[c + 1] += sum_s[c];
+  }
+
+  auto const induce = [&](std::vector<std::int32_t> const &lms) {
+    std::fill(sa.begin(), sa.end(), -1);
+    std::vector<std::int32_t> bucket(sum_s);
+    for (auto d : lms)
+      if (d != n)
+        sa[bucket[s[d]]++] = d;
+    bucket = sum_l;
+    sa[bucket[s[n - 1]]++] = n - 1;
+    for (std::int32_t i = 0; i < n; ++i) {
+      auto const v = sa[i];
+      if (v >= 1 && !is_s[v - 1])
+        sa[bucket[s[v - 1]]++] = v - 1;
+    }
+    bucket = sum_l;
+    for (auto i = n - 1; i >= 0; --i) {
+      auto const v = sa[i];
+      if (v >= 1 && is_s[v - 1])
+        sa[--bucket[s[v - 1] + 1]] = v - 1;
+    }
+  };
+
+  std::vector<std::int32_t> lms_map(n + 1, -1), lms;
+  for (std::int32_t i = 1; i < n; ++i) {
+    if (!is_s[i - 1] && is_s[i]) {
+      lms_map[i] = static_cast<std::int32_t>(lms.size());
+      lms.push_back(i);
+    }
+  }
+  auto const m = static_cast<std::int32_t>(lms.size());
+  induce(lms);
+  if (m == 0)
+    return sa;
+
+  // name the LMS substrings in sorted order, equal substrings share a name
+  std::vector<std::int32_t> sorted_lms;
+  sorted_lms.reserve(m);
+  for (auto v : sa)
+    if (lms_map[v] != -1)
+      sorted_lms.push_back(v);
+
+  std::vector<std::int32_t> reduced(m);
+  std::int32_t names = 0;
+  reduced[lms_map[sorted_lms[0]]] = 0;
+  for (std::int32_t i = 1; i < m; ++i) {
+    auto l = sorted_lms[i - 1], r = sorted_lms[i];
+    auto const end_l = lms_map[l] + 1 < m ? lms[lms_map[l] + 1] : n;
+    auto const end_r = lms_map[r] + 1 < m ? lms[lms_map[r] + 1] : n;
+    bool same = end_l - l == end_r - r;
+    if (same) {
+      for (; l < end_l && s[l] == s[r]; ++l, ++r) {
+      }
+      same = l != n && s[l] == s[r];
+    }
+    if (!same)
+      ++names;
+    reduced[lms_map[sorted_lms[i]]] = names;
+  }
+
+  // sort the LMS suffixes recursively, then induce the final order
+  auto const reduced_sa = sa_is(reduced, names);
+  for (std::int32_t i = 0; i < m; ++i)
+    sorted_lms[i] = lms[reduced_sa[i]];
+  induce(sorted_lms);
+  return sa;
+}
+} // namespace details
+
+// suffix array with LCP array over a text of up to 2^31 - 1 bytes. The suffix
+// array is built with SA-IS in linear time, the rank and LCP arrays (Kasai)
+// are computed in parallel over chunks of the text. Pattern queries are
+// binary searches over the suffixes in O(m log n).
+class SuffixArray {
+public:
+  explicit SuffixArray(
+      std::string text,
+      std::uint32_t const threads = parallel::default_threads())
+      : corpus(std::move(text)) {
+    if (corpus.size() >=
+        static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+      throw std::out_of_range("Text too large for a suffix array");
+
+    std::vector<std::int32_t> symbols(corpus.size());
+    for (std::size_t i = 0; i < corpus.size(); ++i)
+      symbols[i] = static_cast<std::uint8_t>(corpus[i]);
+    suffixes = details::sa_is(symbols, 255);
+    build_lcp(threads);
+  }
+
+  std::string const &text() const { return corpus; }
+  std::vector<std::int32_t> const &suffix_array() const { return suffixes; }
+
+  // lcp()[i]: longest common prefix of the suffixes i - 1 and i, lcp()[0] = 0
+  std::vector<std::int32_t> const &lcp() const { return lcps; }
+
+  // the range of suffixes starting with pattern
+  std::pair<std::size_t, std::size_t> range(std::string const &pattern) const {
+    auto const compare = [&](std::int32_t const suffix) {
+      auto const length = std::min(
+          pattern.size(), corpus.size() - static_cast<std::size_t>(suffix));
+      auto const order =
+          std::memcmp(corpus.data() + suffix, pattern.data(), length);
+      if (order != 0)
+        return order;
+      return length < pattern.size() ? -1 : 0;
+    };
+    auto const begin = std::partition_point(
+        suffixes.begin(), suffixes.end(),
+        [&](std::int32_t suffix) { return compare(suffix) < 0; });
+    auto const end = std::partition_point(
+        begin, suffixes.end(),
+        [&](std::int32_t suffix) { return compare(suffix) == 0; });
+    return {static_cast<std::size_t>(begin - suffixes.begin()),
+            static_cast<std::size_t>(end - suffixes.begin())};
+  }
+
+  std::size_t count(std::string const &pattern) const {
+    auto const found = range(pattern);
+    return found.second - found.first;
+  }
+
+  // all positions of pattern in the text, in increasing order
+  std::vector<std::size_t> find_all(std::string const &pattern) const {
+    auto const found = range(pattern);
+    std::vector<std::size_t> positions(suffixes.begin() + found.first,
+                                       suffixes.begin() + found.second);
+    std::sort(positions.begin(), positions.end());
+    return positions;
+  }
+
+  // binary format: text size, text, suffix array, lcp array
+  void save(std::ostream &out) const {
+    std::uint64_t const size = corpus.size();
+    out.write(reinterpret_cast<char const *>(&size), sizeof(size));
+    out.write(corpus.data(), static_cast<std::streamsize>(size));
+    out.write(reinterpret_cast<char const *>(suffixes.data()),
+              static_cast<std::streamsize>(size * sizeof(std::int32_t)));
+    out.write(reinterpret_cast<char const *>(lcps.data()),
+              static_cast<std::streamsize>(size * sizeof(std::int32_t)));
+  }
+
+  static SuffixArray load(std::istream &in) {
+    std::uint64_t size = 0;
+    in.read(reinterpret_cast<char *>(&size), sizeof(size));
+    if (!in || size >= static_cast<std::uint64_t>(
+                           std::numeric_limits<std::int32_t>::max()))
+      throw std::runtime_error("Invalid suffix array header");
+
+    SuffixArray result;
+    result.corpus.resize(size);
+    result.suffixes.resize(size);
+    result.lcps.resize(size);
+    in.read(&result.corpus[0], static_cast<std::streamsize>(size));
+    in.read(reinterpret_cast<char *>(result.suffixes.data()),
+            static_cast<std::streamsize>(size * sizeof(std::int32_t)));
+    in.read(reinterpret_cast<char *>(result.lcps.data()),
+            static_cast<std::streamsize>(size * sizeof(std::int32_t)));
+    if (!in)
+      throw std::runtime_error("Truncated suffix array");
+    return result;
+  }
+
+private:
+  SuffixArray() = default;
+
+  // Kasai et al. Every chunk of text positions restarts with an empty common
+  // prefix, which keeps the result exact and the work linear per chunk
+  void build_lcp(std::uint32_t const threads) {
+    auto const n = suffixes.size();
+    std::vector<std::int32_t> rank(n);
+    parallel::for_each_chunk(
+        n, threads, [&](std::uint32_t, std::size_t begin, std::size_t end) {
+          for (auto i = begin; i < end; ++i)
+            rank[suffixes[i]] = static_cast<std::int32_t>(i);
+        });
+
+    lcps.assign(n, 0);
+    parallel::for_each_chunk(
+        n, threads, [&](std::uint32_t, std::size_t begin, std::size_t end) {
+          std::size_t h = 0;
+          for (auto i = begin; i < end; ++i) {
+            if (rank[i] == 0) {
+              h = 0;
+              continue;
+            }
+            auto const j = static_cast<std::size_t>(suffixes[rank[i] - 1]);
+            while (i + h < n && j + h < n && corpus[i + h] == corpus[j + h])
+              ++h;
+            lcps[rank[i]] = static_cast<std::int32_t>(h);
+            if (h)
+              --h;
+          }
+        });
+  }
+
+  std::string corpus;
+  std::vector<std::int32_t> suffixes;
+  std::vector<std::int32_t> lcps;
+};
+
+} // namespace strings
+} // namespace eopi
+
+#endif // EOPI_STRINGS_SUFFIX_ARRAY_HPP_
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 
@@ -26,6 +28,28 @@ int main() {
   eopi::arrays::three_way_partition(data.begin(), data.end(), 3);
   print(data);
 
+  vector<int> blocked_data(200), vectorised_data(200);
+  for (size_t i = 0; i < blocked_data.size(); ++i)
+    blocked_data[i] = vectorised_data[i] = static_cast<int>((i * 37) % 11);
+  auto const blocked = eopi::arrays::three_way_partition_blocked(
+      blocked_data.begin(), blocked_data.end(), 5, std::less<int>());
+  auto const vectorised = eopi::arrays::three_way_partition_vectorised(
+      vectorised_data.data(), vectorised_data.data() + vectorised_data.size(),
+      5);
+  cout << "Blocked partition by 5: [" << blocked.first - blocked_data.begin()
+       << "," << blocked.second - blocked_data.begin() << ") sorted: "
+       << is_sorted(blocked_data.begin(), blocked_data.end(),
+                    [](int l, int r) { return (l > 5) - (l < 5) <
+                                              (r > 5) - (r < 5); })
+       << endl;
+  cout << "Vectorised partition by 5: ["
+       << vectorised.first - vectorised_data.data() << ","
+       << vectorised.second - vectorised_data.data() << ") sorted: "
+       << is_sorted(vectorised_data.begin(), vectorised_data.end(),
+                    [](int l, int r) { return (l > 5) - (l < 5) <
+                                              (r > 5) - (r < 5); })
+       << endl;
+
   eopi::arrays::BigInt value("1234567891234567891234567890");
   cout << "Big value: " << value << endl;
   ++value;
@@ -1,10 +1,15 @@
 #include <cstdint>
 #include <iostream>
+#include <numeric>
+#include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#include "arrays/bigint.hpp"
 #include "dp/algorithms.hpp"
+#include "dp/fuzzy_search.hpp"
+#include "dp/memo.hpp"
 
 using namespace std;
 
@@ -13,9 +18,60 @@ int main() {
     cout << "Can reach a score of 12 in : "
          << eopi::dp::algorithms::football_combinations(12) << " ways." << endl;
   }
+  {
+    // exact counts for a score of 10^18, and modulo a prime for many coins
+    using eopi::dp::algorithms::coin_change_count;
+    cout << "Can reach a score of 10^18 in: "
+         << coin_change_count<eopi::arrays::BigInt>({2, 3, 7},
+                                                    1000000000000000000ull)
+         << " ways." << endl;
+    cout << "Change for 10^18 pence mod 10^9+7: "
+         << coin_change_count<eopi::dp::algorithms::Modular<1000000007>>(
+                {1, 2, 5, 10, 20, 50, 100, 200}, 1000000000000000000ull)
+         << " ordered for 100: "
+         << coin_change_count<eopi::arrays::BigInt>(
+                {1, 2, 5}, 100, eopi::dp::algorithms::CoinOrder::sequences)
+         << endl;
+  }
   { // levensthein
     cout << "Tor and Tier are editable in: "
          << eopi::dp::algorithms::levenshtein_distance("Tor", "Tier") << endl;
+
+    // patterns longer than a machine word use multiple blocks
+    string const lhs(200, 'a');
+    string rhs = lhs;
+    rhs[10] = 'b';
+    rhs.erase(100, 3);
+    using eopi::dp::algorithms::levenshtein_within;
+    cout << "Long strings are editable in: "
+         << eopi::dp::algorithms::levenshtein_distance(lhs, rhs)
+         << ", within 3: " << levenshtein_within(lhs, rhs, 3)
+         << ", within 4: " << levenshtein_within(lhs, rhs, 4) << endl;
+    cout << "Within any distance: "
+         << levenshtein_within("kitten", "sitting", 0xFFFFFFFF) << endl;
+  }
+  {
+    // one query against a generated dictionary of 20000 words
+    vector<string> words;
+    for (uint32_t i = 0; i < 20000; ++i) {
+      string word;
+      for (auto value = i * 2654435761u; word.size() < 4 + i % 8; value /= 7)
+        word += static_cast<char>('a' + value % 7);
+      words.push_back(word);
+    }
+    words.push_back("algorithm");
+
+    cout << "Closest words:";
+    for (auto const &match :
+         eopi::dp::algorithms::closest_words("algoritm", words, 3))
+      cout << " " << words[match.second] << " (" << match.first << ")";
+    cout << endl;
+
+    eopi::dp::algorithms::WordTrie const trie(words);
+    cout << "Trie:";
+    for (auto const &match : trie.closest("algoritm", 3))
+      cout << " " << words[match.second] << " (" << match.first << ")";
+    cout << endl;
   }
   {
     // fishing trip
@@ -26,6 +82,15 @@ int main() {
                                     {2, 1, 4, 0, 3}};
 
     cout << "Max yield: " << eopi::dp::algorithms::fishing_trip(fish) << endl;
+
+    // a large lake, sequential with one line of memory and tiled in parallel
+    vector<vector<int32_t>> lake(1500, vector<int32_t>(1000));
+    for (size_t row = 0; row < lake.size(); ++row)
+      for (size_t col = 0; col < lake[row].size(); ++col)
+        lake[row][col] = static_cast<int32_t>((row * 7919 + col * 104729) % 10);
+    cout << "Max yield large: " << eopi::dp::algorithms::fishing_trip(lake)
+         << " parallel: " << eopi::dp::algorithms::fishing_trip(lake, 4)
+         << endl;
   }
   {
     vector<pair<uint32_t, uint32_t>> values = {{1, 5}, {5, 1}, {2, 3}};
@@ -40,22 +105,117 @@ int main() {
     cout << "Knapsack: " << eopi::dp::algorithms::knapsack_zero_one(values, 130)
          << endl;
   }
+  {
+    // unit values with a huge capacity run as a bitset subset sum, few items
+    // with a huge capacity meet in the middle
+    using eopi::dp::algorithms::KnapsackItem;
+    vector<KnapsackItem> unit, few;
+    for (uint32_t i = 0; i < 100; ++i) {
+      auto const weight = (i * 2654435761u) % 100000u + 1;
+      unit.emplace_back(weight, weight);
+    }
+    for (uint32_t i = 0; i < 32; ++i)
+      few.emplace_back((i * 40503u) % 1000u + 1,
+                       (i * 2654435761u) % 10000000u + 1);
+    for (auto const *items : {&unit, &few}) {
+      auto const solution = eopi::dp::algorithms::knapsack(*items, 2000000);
+      cout << "Knapsack " << items->size() << " items: " << solution.value
+           << " using " << solution.items.size() << " items, mode "
+           << static_cast<int>(
+                  eopi::dp::algorithms::knapsack_mode(*items, 2000000))
+           << endl;
+    }
+    // past the limit the halves no longer meet
+    vector<KnapsackItem> many;
+    for (uint32_t i = 0; i <= eopi::dp::algorithms::MEET_IN_THE_MIDDLE_ITEMS;
+         ++i)
+      many.emplace_back(i % 7 + 1, (i * 2654435761u) % 1000000u + 1);
+    cout << "Knapsack " << many.size() << " items meet in the middle: "
+         << (eopi::dp::algorithms::knapsack_mode(many, 20000000) ==
+             eopi::dp::algorithms::KnapsackMode::meet_in_the_middle)
+         << endl;
+  }
   {
     cout << "Measure: ";
     eopi::dp::algorithms::measure(2100, 2300);
+    // the fewest cups come first, a huge max costs nothing
+    cout << "Measure: ";
+    eopi::dp::algorithms::measure(200, 1000);
+    cout << "Measure: ";
+    eopi::dp::algorithms::measure(200, 4000000000u);
+  }
+  {
+    // one table answers many queries
+    eopi::dp::algorithms::MeasureTable const table(
+        {{230, 240}, {290, 310}, {500, 515}, {750, 760}}, 5000, 6000);
+    cout << "Measurable:";
+    for (auto const &query : vector<pair<uint32_t, uint32_t>>{
+             {2100, 2300}, {240, 260}, {4980, 5010}, {5000, 6000}})
+      cout << " [" << query.first << "," << query.second
+           << "]=" << table.feasible(query.first, query.second) << "/"
+           << table.combination(query.first, query.second).size();
+    cout << endl;
   }
   {
     vector<int32_t> data = {904, 40, 523, 12, -335, -385, -124, 481, -31};
     cout << "Subset sum: "
          << eopi::dp::algorithms::max_subarray_sum_cyclic(data) << endl;
   }
+  {
+    vector<int32_t> data(1 << 22);
+    uint32_t state = 7;
+    for (auto &value : data) {
+      state = state * 1664525u + 1013904223u;
+      value = static_cast<int32_t>(state >> 20) - 2047;
+    }
+    cout << "Cyclic sum large: "
+         << eopi::dp::algorithms::max_subarray_sum_cyclic(data)
+         << " parallel: "
+         << eopi::dp::algorithms::max_subarray_sum_cyclic(data, 4) << endl;
+
+    // best subarray among the last 1000 values of the stream
+    eopi::dp::algorithms::SlidingSubarray window(1000);
+    int64_t best = 0;
+    for (auto value : data) {
+      window.push(value);
+      best = max(best, window.best());
+    }
+    cout << "Best in a window of 1000: " << best << endl;
+  }
   { cout << "Floors: " << eopi::dp::algorithms::critical_case(1, 15) << endl; }
   { cout << "Floors: " << eopi::dp::algorithms::critical_case(2, 15) << endl; }
+  {
+    cout << "Floors: " << eopi::dp::algorithms::critical_case(10, 60) << endl;
+    cout << "Drops for 100 floors: "
+         << eopi::dp::algorithms::minimum_drops(2, 100)
+         << " for 10^9 floors: "
+         << eopi::dp::algorithms::minimum_drops(3, 1000000000) << endl;
+  }
   {
     vector<uint32_t> data = {25, 5,  10, 5,  10, 5,  10, 25,
                              1,  25, 1,  25, 1,  25, 5,  10};
-    cout << "Max gain player 1: " << eopi::dp::algorithms::max_coin_gain(data)
-         << endl;
+    auto const gain = eopi::dp::algorithms::max_coin_gain(data);
+    auto const total = accumulate(data.begin(), data.end(), 0u);
+    cout << "Total: " << total << " Profit: " << (total + gain) / 2 << endl;
+    cout << "Max gain player 1: " << gain << endl;
+  }
+  {
+    // a tiny memo grows many times, probing past occupied slots
+    eopi::dp::FlatMemo<uint32_t> memo(1);
+    for (uint32_t i = 0; i < 1000; ++i)
+      memo.insert(eopi::dp::memo_key(i, 1000 - i), i);
+    for (uint32_t i = 0; i < 1000; i += 2)
+      memo.insert(eopi::dp::memo_key(i, 1000 - i), 2 * i);
+    uint32_t found = 0, correct = 0;
+    for (uint32_t i = 0; i < 1000; ++i) {
+      auto const value = memo.find(eopi::dp::memo_key(i, 1000 - i));
+      found += value != nullptr;
+      correct += value && *value == (i % 2 ? i : 2 * i);
+    }
+    cout << "Memo size: " << memo.size() << " found: " << found
+         << " correct: " << correct
+         << " absent: " << memo.contains(eopi::dp::memo_key(1000, 1000))
+         << memo.contains(eopi::dp::memo_key(1, 1)) << endl;
   }
   {
     vector<int32_t> data = {0, 8, 4, 12, 2, 10, 6, 14, 1, 9};
@@ -65,6 +225,26 @@ int main() {
       cout << " " << e;
     cout << endl;
   }
+  {
+    // a pseudo random walk, length only and split across two threads
+    vector<int32_t> data(1 << 22);
+    uint32_t state = 1;
+    int32_t level = 0;
+    for (auto &value : data) {
+      state = state * 1664525u + 1013904223u;
+      level += static_cast<int32_t>(state >> 28) - 7;
+      value = level;
+    }
+    eopi::dp::algorithms::NondecreasingLength stream;
+    for (auto value : data)
+      stream.push(value);
+    cout << "Nondecreasing length: " << stream.size() << " parallel: "
+         << eopi::dp::algorithms::longest_nondecreasing_length(data, 2)
+         << " sequence: "
+         << eopi::dp::algorithms::longest_nondecreasing_subsequence(data, 2)
+                .size()
+         << endl;
+  }
   {
     vector<vector<bool>> field = {{false, true, false, false, false},
                                   {false, true, false, true, true},
@@ -79,5 +259,19 @@ int main() {
     cout << "Max Square: (" << std::get<0>(max_square) << ","
          << std::get<1>(max_square) << ") - (" << std::get<2>(max_square) << ","
          << std::get<3>(max_square) << ")" << endl;
+
+    // a large raster streamed row by row next to the packed field in bands
+    eopi::dp::BitMatrix raster(2000, 1000);
+    eopi::dp::algorithms::LargestRectangle stream(raster.cols());
+    for (size_t row = 0; row < raster.rows(); ++row) {
+      for (size_t col = 0; col < raster.cols(); ++col)
+        raster.set(row, col, (row * 7919 + col * 104729) % 23 != 0);
+      stream.push_row(raster.row(row));
+    }
+    auto const banded = eopi::dp::algorithms::max_subarray(raster, 4);
+    cout << "Max Rect large: " << stream.area() << " ("
+         << std::get<0>(banded) << "," << std::get<1>(banded) << ") - ("
+         << std::get<2>(banded) << "," << std::get<3>(banded) << ")"
+         << (banded == stream.result() ? "" : " mismatch") << endl;
   }
 }
@@ -11,6 +11,7 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <string>
 
 using namespace std;
 
@@ -65,6 +66,26 @@ int main() {
        << " AA: " << eopi::primitives::spreadsheet_encoding("AA")
        << " Z: " << eopi::primitives::spreadsheet_encoding("Z")
        << " AZ: " << eopi::primitives::spreadsheet_encoding("AZ") << endl;
+  cout << "Columns: 52: " << eopi::primitives::to_spreadsheet(52)
+       << " 703: " << eopi::primitives::to_spreadsheet(703) << endl;
+
+  {
+    // batch conversion of delimited fields without allocations
+    string const fields = "ff\n7f\n10\n";
+    char converted[3 * 66];
+    auto const end = eopi::primitives::convert_base(
+        fields.data(), fields.data() + fields.size(), '\n', 16, 2, converted);
+    cout << "Batch base 16 to 2: " << string(converted, end);
+
+    string const columns = "A,Z,AA,AZ,ZZ";
+    uint64_t values[5];
+    auto const count = eopi::primitives::spreadsheet_encoding(
+        columns.data(), columns.data() + columns.size(), ',', values);
+    cout << "Batch columns:";
+    for (size_t i = 0; i < count; ++i)
+      cout << " " << values[i];
+    cout << endl;
+  }
   cout << "Reverse 12345678: " << eopi::primitives::reverse_digits(12345678)
        << std::endl;
 
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <iostream>
 #include <numeric>
 #include <vector>
@@ -96,6 +97,25 @@ int main() {
          << " (Elements: " << data[min_max.first] << " " << data[min_max.second]
          << ")" << std::endl;
   }
+  {
+    // first occurrences, vectorised / parallel / comparator based
+    std::vector<int> data(1000);
+    for (size_t i = 0; i < data.size(); ++i)
+      data[i] = static_cast<int>((i * 7919) % 613);
+    data[17] = data[923] = -5;
+    data[400] = data[401] = 1000;
+    auto vectorised = eopi::search::algorithm::min_max(data);
+    auto parallel = eopi::search::algorithm::min_max_parallel(data, 4);
+    auto pairwise = eopi::search::algorithm::min_max(data, std::less<int>());
+    cout << "Min max (vectorised): " << vectorised.first << " "
+         << vectorised.second << " (parallel): " << parallel.first << " "
+         << parallel.second << " (pairwise): " << pairwise.first << " "
+         << pairwise.second << endl;
+    // zero threads still reduce on the calling one
+    auto const serial = eopi::search::algorithm::min_max_parallel(data, 0);
+    cout << "Min max (no threads): " << serial.first << " " << serial.second
+         << endl;
+  }
   {
     std::vector<int> data = {3, 2, 5, 1, 2, 4};
     auto second_smallest = eopi::search::algorithm::quick_select(2, data);
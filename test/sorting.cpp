@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <string>
 #include <vector>
 
 #include "sorting/algorithms.hpp"
@@ -16,6 +19,30 @@ int main() {
       cout << " " << i;
     cout << endl;
   }
+  {
+    // skewed, block-wise and multi-way intersection
+    vector<int> small = {3, 40, 41, 999, 4000}, large(5000), evens(2000);
+    for (size_t i = 0; i < large.size(); ++i)
+      large[i] = static_cast<int>(i);
+    for (size_t i = 0; i < evens.size(); ++i)
+      evens[i] = static_cast<int>(2 * i);
+
+    auto const print = [](string const &name, vector<int> const &values) {
+      cout << name << ":";
+      for (auto v : values)
+        cout << " " << v;
+      cout << endl;
+    };
+    print("Galloping",
+          eopi::sorting::algorithms::set_intersect_galloping(small, large));
+    print("Adaptive",
+          eopi::sorting::algorithms::set_intersect_adaptive(large, small));
+    cout << "Block intersection size: "
+         << eopi::sorting::algorithms::set_intersect_block(large, evens).size()
+         << endl;
+    print("Multi-way", eopi::sorting::algorithms::set_intersect(
+                           vector<vector<int>>{large, evens, small}));
+  }
   {
     // inplace merge
     vector<int> lhs = {2, 3, 5, 6, 7, 8, 12}, rhs = {1, 4, 9, 10, 11};
@@ -26,6 +53,22 @@ int main() {
       cout << " " << l;
     cout << endl;
   }
+  {
+    // parallel merging and merge sort
+    vector<int> lhs = {2, 3, 5, 6, 7, 8, 12}, rhs = {1, 4, 9, 10, 11};
+    eopi::sorting::algorithms::semi_inplace_merge_parallel(lhs, rhs, 4);
+    cout << "Merged (parallel):";
+    for (auto l : lhs)
+      cout << " " << l;
+    cout << endl;
+
+    vector<int> data(100000);
+    for (size_t i = 0; i < data.size(); ++i)
+      data[i] = static_cast<int>((i * 7919) % 100003);
+    eopi::sorting::algorithms::merge_sort_parallel(data, 3);
+    cout << "Merge sorted (parallel): " << is_sorted(data.begin(), data.end())
+         << endl;
+  }
   {
     // optimal pair schedule
     vector<uint32_t> durations = {5, 1, 6, 2, 4, 4};
@@ -59,4 +102,83 @@ int main() {
     }
     cout << endl;
   }
+  {
+    struct record {
+      typedef int32_t key_type;
+      key_type key() const { return k; }
+      int32_t k;
+      char tag;
+    };
+
+    vector<record> records;
+    for (int32_t i = 0; i < 12; ++i)
+      records.push_back({((i * 7919) % 13) * 100000 - 600000,
+                         static_cast<char>('a' + i)});
+    records.push_back({-600000, 'z'});
+
+    auto const print = [](string const &name, vector<record> const &sorted) {
+      cout << name << ":";
+      for (auto const &r : sorted)
+        cout << " " << r.k << r.tag;
+      cout << endl;
+    };
+
+    auto in_place = records, lsd = records, parallel = records;
+    eopi::sorting::algorithms::counting_sort(in_place);
+    eopi::sorting::algorithms::radix_sort(lsd);
+    eopi::sorting::algorithms::radix_sort_parallel(parallel, 3);
+    cout << "American flag sorted: "
+         << is_sorted(in_place.begin(), in_place.end(),
+                      [](auto l, auto r) { return l.k < r.k; })
+         << endl;
+    print("Radix sorted", lsd);
+    print("Parallel radix sorted", parallel);
+  }
+  {
+    // enough records for the American flag permutation to run on every
+    // digit: few distinct keys, negative keys and keys that only differ in
+    // their highest byte
+    struct record {
+      typedef int32_t key_type;
+      key_type key() const { return k; }
+      int32_t k;
+      uint32_t tag;
+    };
+
+    vector<record> records;
+    uint32_t state = 1;
+    for (uint32_t i = 0; i < 5000; ++i) {
+      state = state * 1664525u + 1013904223u;
+      auto const high = static_cast<int32_t>(state >> 29) - 4;
+      auto const low = static_cast<int32_t>((state >> 20) % 3);
+      records.push_back({high * (1 << 24) + low, i});
+    }
+
+    auto const by_key = [](record const &l, record const &r) {
+      return l.k < r.k;
+    };
+    auto const same = [](vector<record> const &l, vector<record> const &r) {
+      return equal(l.begin(), l.end(), r.begin(), r.end(),
+                   [](record const &a, record const &b) {
+                     return a.k == b.k && a.tag == b.tag;
+                   });
+    };
+    auto stable = records;
+    stable_sort(stable.begin(), stable.end(), by_key);
+
+    auto in_place = records, lsd = records, parallel = records;
+    eopi::sorting::algorithms::counting_sort(in_place);
+    eopi::sorting::algorithms::radix_sort(lsd);
+    eopi::sorting::algorithms::radix_sort_parallel(parallel, 3);
+
+    // the in-place sort is unstable, compare it as a multiset of records
+    auto by_tag = in_place;
+    sort(by_tag.begin(), by_tag.end(),
+         [](record const &l, record const &r) { return l.tag < r.tag; });
+    cout << "Large American flag sorted: "
+         << is_sorted(in_place.begin(), in_place.end(), by_key)
+         << " permutation: " << same(by_tag, records)
+         << " radix stable: " << same(lsd, stable)
+         << " parallel stable: " << same(parallel, stable) << endl;
+  }
 }
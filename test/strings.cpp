@@ -1,8 +1,16 @@
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <sstream>
 #include <string>
 
+#include "strings/aho_corasick.hpp"
 #include "strings/algorithm.hpp"
+#include "strings/bit_codes.hpp"
+#include "strings/integer_codecs.hpp"
+#include "strings/rabin_karp.hpp"
 #include "strings/random.hpp"
+#include "strings/suffix_array.hpp"
 
 using namespace std;
 
@@ -19,6 +27,36 @@ int main() {
        << eopi::strings::reverse_words("This is a senctence")
        << "\" Word: " << eopi::strings::reverse_words("Word") << endl;
 
+  {
+    string utf8 = "Grüße aus Köln €";
+    eopi::strings::reverse_words(&utf8[0], &utf8[0] + utf8.size());
+    cout << "UTF-8 words: " << utf8;
+    eopi::strings::reverse_code_points(&utf8[0], &utf8[0] + utf8.size());
+    cout << " Code points: " << utf8 << endl;
+
+    // in place on a larger buffer: reversing twice restores the text and
+    // the new size follows from the counts of 'a' and 'b'
+    string words;
+    for (size_t i = 0; words.size() < (1 << 16); ++i)
+      words.append(1 + (i * 7919) % 12, static_cast<char>('a' + i % 26)) += ' ';
+    auto const original = words;
+    eopi::strings::reverse_words(&words[0], &words[0] + words.size());
+    auto const reversed = words != original;
+    eopi::strings::reverse_words(&words[0], &words[0] + words.size());
+    auto const restored = reversed && words == original;
+
+    auto const half = words.size() / 2;
+    auto const begin = words.begin(), middle = words.begin() + half;
+    auto const expected = half +
+                          static_cast<size_t>(count(begin, middle, 'a')) -
+                          static_cast<size_t>(count(begin, middle, 'b'));
+    auto const size =
+        eopi::strings::remove_and_replace(&words[0], half, words.size());
+    cout << "Reverse words twice: " << restored
+         << ", remove and replace: " << size << " bytes, expected: "
+         << expected << endl;
+  }
+
   cout << "Phone Mnemonics: 1234" << endl;
 
   eopi::strings::print_mnemonics(123);
@@ -36,6 +74,23 @@ int main() {
   cout << "\tIV:" << eopi::strings::from_roman("IV") << endl;
   cout << "\tXXXIV:" << eopi::strings::from_roman("XXXIV") << endl;
   cout << "\tCLIX:" << eopi::strings::from_roman("CLIX") << endl;
+  cout << "\t1994: " << eopi::strings::to_roman(1994) << endl;
+
+  {
+    // batch round trip of all numerals through one buffer
+    vector<uint32_t> values(4000);
+    for (uint32_t i = 0; i < values.size(); ++i)
+      values[i] = i;
+    string numerals(15 * values.size(), ' ');
+    auto const end = eopi::strings::to_roman(
+        values.data(), values.data() + values.size(), '\n', &numerals[0]);
+    vector<uint32_t> parsed(values.size());
+    auto const count = eopi::strings::from_roman(&numerals[0], end, '\n',
+                                                 parsed.data());
+    cout << "\tBatch of " << count << " numerals, "
+         << (end - &numerals[0]) << " bytes, round trip: " << (parsed == values)
+         << endl;
+  }
 
   cout << "All Ips for 19216811\n";
   eopi::strings::all_valid_ips("19216811");
@@ -49,6 +104,36 @@ int main() {
   cout << encoding << endl;
   cout << "Decoded: " << eopi::strings::runlength::decode(encoding) << endl;
 
+  {
+    // binary runlength format streamed in small uneven chunks, runs up to
+    // 1000 bytes cross many chunks and their varints cross chunk borders
+    string runs;
+    for (size_t i = 0; runs.size() < (1 << 16); ++i)
+      runs.append(1 + (i * 7919) % 1000, static_cast<char>('a' + i % 3));
+
+    size_t const sizes[] = {1, 7, 64, 3, 300, 2, 129};
+    eopi::strings::runlength::BinaryEncoder encoder;
+    vector<uint8_t> binary;
+    for (size_t begin = 0, i = 0; begin < runs.size(); ++i) {
+      auto const end = min(runs.size(), begin + sizes[i % 7]);
+      encoder.encode(runs.data() + begin, runs.data() + end, binary);
+      begin = end;
+    }
+    encoder.finish(binary);
+
+    eopi::strings::runlength::BinaryDecoder decoder;
+    string restored;
+    for (size_t begin = 0, i = 0; begin < binary.size(); ++i) {
+      auto const end = min(binary.size(), begin + sizes[(i + 3) % 7]);
+      decoder.decode(binary.data() + begin, binary.data() + end, restored);
+      begin = end;
+    }
+    cout << "Binary RLE: " << runs.size() << " -> " << binary.size()
+         << " bytes, as one chunk: "
+         << (binary == eopi::strings::runlength::encode_binary(runs))
+         << ", lossless: " << (restored == runs) << endl;
+  }
+
   vector<uint32_t> egd = {13, 13};
   auto const encoded = eopi::strings::elias_gamma_code::encode(egd);
   cout << "Egc: " << encoded << endl;
@@ -58,10 +143,71 @@ int main() {
     cout << " " << v;
   cout << endl;
 
+  {
+    // bit-packed codecs over 65536 gaps
+    vector<uint32_t> gaps(1 << 16);
+    for (size_t i = 0; i < gaps.size(); ++i)
+      gaps[i] = 1 + static_cast<uint32_t>((i * 7919) % 61);
+
+    auto const report = [&](string const &name, auto const &encoded,
+                            auto const &decode, size_t const bytes) {
+      cout << name << ": " << bytes << " bytes, lossless: "
+           << (decode(encoded) == gaps) << endl;
+    };
+    auto const gamma = eopi::strings::elias_gamma_packed::encode(gaps);
+    report("Gamma", gamma, eopi::strings::elias_gamma_packed::decode,
+           8 * gamma.size());
+    auto const delta = eopi::strings::elias_delta::encode(gaps);
+    report("Delta", delta, eopi::strings::elias_delta::decode,
+           8 * delta.size());
+    auto const rice = eopi::strings::golomb_rice::encode(gaps);
+    report("Rice", rice, eopi::strings::golomb_rice::decode, 8 * rice.size());
+    auto const varint = eopi::strings::varint::encode(gaps);
+    report("Varint", varint, eopi::strings::varint::decode, varint.size());
+
+    // block codecs over the same gaps as a sorted postings list
+    vector<uint32_t> postings(gaps.size());
+    uint32_t sum = 0;
+    for (size_t i = 0; i < gaps.size(); ++i)
+      postings[i] = sum += gaps[i];
+    auto const blocks = [&](string const &name, auto const &compressed) {
+      cout << name << ": " << compressed.bytes() << " bytes, lossless: "
+           << (compressed.decode() == postings)
+           << ", lower_bound(1000000): " << compressed.lower_bound(1000000)
+           << endl;
+    };
+    using eopi::strings::CompressedPostings;
+    blocks("FOR", CompressedPostings<eopi::strings::ForCodec>(postings));
+    blocks("PFOR", CompressedPostings<eopi::strings::PforCodec>(postings));
+    blocks("Stream VByte",
+           CompressedPostings<eopi::strings::StreamVByteCodec>(postings));
+    blocks("BP128", CompressedPostings<eopi::strings::Bp128Codec>(postings));
+  }
+
   vector<string> justified = {"Hallo", "Welt", "was",  "ist",
                               "mit",   "dir",  "denn", "los"};
   eopi::strings::print_justified(justified, 11);
 
+  {
+    vector<string> const paragraph = {"aaa", "bb", "cc", "ddddd"};
+    eopi::strings::Justifier<eopi::strings::OstreamSink> minimum(
+        6, eopi::strings::OstreamSink(cout),
+        eopi::strings::Layout::minimum_raggedness);
+    minimum.paragraph(paragraph);
+    minimum.flush();
+
+    // lazily justify 100 paragraphs from a stream into a buffered sink
+    string report;
+    for (size_t i = 0; i < 100; ++i)
+      report += "Sed ut perspiciatis unde omnis iste natus error sit "
+                "voluptatem accusantium doloremque laudantium\n\n";
+    istringstream input(report);
+    ostringstream output;
+    eopi::strings::justify_stream(input, 40, eopi::strings::OstreamSink(output),
+                                  eopi::strings::Layout::minimum_raggedness);
+    cout << "Justified " << output.str().size() << " bytes" << endl;
+  }
+
   string text =
       "Sed ut perspiciatis unde omnis iste natus error sit voluptatem "
       "accusantium doloremque laudantium, totam rem aperiam, eaque ipsa quae "
@@ -94,6 +240,79 @@ int main() {
 
   auto pos = eopi::strings::rabin_karp(text, pattern);
   cout << "Found pattern at: " << pos << std::endl;
+  cout << "Two-way: " << eopi::strings::two_way(text, pattern)
+       << " Adaptive: " << eopi::strings::find(text, pattern) << " Long: "
+       << eopi::strings::find(text, "Temporibus autem quibusdam et aut "
+                                    "officiis debitis")
+       << endl;
+
+  {
+    // feed the text in chunks of 100 bytes, directly and through a stream
+    eopi::strings::RabinKarpStream matcher("voluptatem");
+    cout << "Streamed matches:";
+    for (std::size_t chunk = 0; chunk < text.size(); chunk += 100)
+      matcher.scan(text.data() + chunk,
+                   text.data() + std::min(chunk + 100, text.size()),
+                   [](auto const position) { cout << " " << position; });
+    cout << endl;
+
+    matcher.reset();
+    istringstream input(text);
+    cout << "From stream:";
+    eopi::strings::scan_stream(
+        input, matcher, [](auto const position) { cout << " " << position; },
+        64);
+    cout << endl;
+  }
+
+  {
+    eopi::strings::SuffixArray suffixes(text);
+    cout << "Suffix array matches:";
+    for (auto const position : suffixes.find_all("voluptatem"))
+      cout << " " << position;
+    auto const &lcp = suffixes.lcp();
+    auto const longest = max_element(lcp.begin(), lcp.end()) - lcp.begin();
+    cout << "\nLongest repeat: \""
+         << text.substr(suffixes.suffix_array()[longest], lcp[longest])
+         << "\"";
+
+    stringstream file;
+    suffixes.save(file);
+    auto const loaded = eopi::strings::SuffixArray::load(file);
+    cout << " Loaded count of \"qui\": " << loaded.count("qui") << endl;
+  }
+
+  {
+    eopi::strings::AhoCorasick automaton({"he", "she", "his", "hers"});
+    cout << "Aho-Corasick in \"ushers, his\":";
+    for (auto const &match : automaton.find_all("ushers, his"))
+      cout << " (" << match.first << "," << match.second << ")";
+    cout << endl;
+
+    // a match straddling the chunks
+    cout << "Chunked:";
+    for (auto const chunk : {"us", "h", "ers"})
+      automaton.scan(chunk, [](auto const pattern, auto const position) {
+        cout << " (" << pattern << "," << position << ")";
+      });
+    cout << endl;
+  }
+
+  {
+    // more start bytes than vector compares handle, low and high nibbles of
+    // the start bytes spread over the classifier tables
+    eopi::strings::AhoCorasick automaton(
+        {"alpha", "Beta", "gamma", "7delta", "~eps", "\xC3zeta", "eta", "Z"});
+    string text(100, '.');
+    text.replace(40, 5, "alpha");
+    text.replace(70, 3, "eta");
+    text.replace(90, 2, "\xC3z");
+    text += "~eps Z";
+    cout << "Aho-Corasick many starts:";
+    for (auto const &match : automaton.find_all(text))
+      cout << " (" << match.first << "," << match.second << ")";
+    cout << endl;
+  }
 
   return 0;
 }